@@ -1,5 +1,10 @@
 #include "AI.h"
+#include "AllocationTracker.h"
+#include "Rules.h"
+#include "Trace.h"
+#include "Zobrist.h"
 #include <algorithm>
+#include <climits>
 #include <cmath>
 #include <random>
 using namespace sf;
@@ -8,15 +13,29 @@ AI::AI()
 {
 }
 
-Move AI::findBestMove(const vector<vector<Piece*>>& board, vector<Piece>& p2Pieces, 
-	vector<Piece>& p1Pieces, int gridSize, bool isPlacementPhase, int depth, bool useRandomPlacement, const Move& lastMove, Strategy strategy)
+Move AI::findBestMove(Position position, int depth, bool useRandomPlacement, const Move& lastMove, Strategy strategy,
+	const PositionHistory& history)
 {
+	Trace::Zone zone("AI::findBestMove", "depth", depth);
 	m_strategy = strategy;
-	vector<vector<Piece*>> boardCopy = board;
+	m_lastMoveCached = false;
+	m_lastMoveFromBook = false;
+	m_lastSearchDepth = depth;
+	m_nodesSearched = 0;
+	m_stopped = false;
+	const auto searchStart = std::chrono::steady_clock::now();
+	AllocationTracker::begin();
+	m_stats = SearchStats();
+	m_rootMoves.clear();
+	m_rootDepth = depth;
+	m_pvLength[0] = 0;
+	m_pvLength[1] = 0;
+	m_perspective = position.player1ToMove ? -1 : 1;
+	const bool isPlacementPhase = position.placementPhase;
 	
 	// In AI vs AI mode during placement, use random placement for variety
 	if (useRandomPlacement && isPlacementPhase) {
-		vector<Move> possibleMoves = generateMoves(boardCopy, p2Pieces, gridSize, isPlacementPhase);
+		vector<Move> possibleMoves = generateMoves(position);
 		
 		if (!possibleMoves.empty()) {
 			std::random_device rd;
@@ -27,16 +46,17 @@ Move AI::findBestMove(const vector<vector<Piece*>>& board, vector<Piece>& p2Piec
 			m_selectedMove = possibleMoves[randomIndex];
 			m_movesConsidered = possibleMoves.size();
 			m_bestScore = 0;
+			m_journalPending = false;
+			updatePrincipalVariation(0, m_selectedMove);
+			finishSearchStats(searchStart);
 			return m_selectedMove;
 		}
 	}
 	
 	int bestScore = INT_MIN;
 	Move bestMove;
-	int alpha = INT_MIN;
-	int beta = INT_MAX;
 
-	vector<Move> possibleMoves = generateMoves(boardCopy, p2Pieces, gridSize, isPlacementPhase);
+	vector<Move> possibleMoves = generateMoves(position);
 	
 	// Filter out moves that would immediately undo the last move
 	if (!isPlacementPhase && lastMove.pieceIndex >= 0) {
@@ -61,71 +81,382 @@ Move AI::findBestMove(const vector<vector<Piece*>>& board, vector<Piece>& p2Piec
 	
 	m_movesConsidered = possibleMoves.size();
 
+	// Book moves answer the expensive early placement searches instantly
+	if (isPlacementPhase && probeOpeningBook(position, possibleMoves, bestMove)) {
+		m_bestScore = 0;
+		m_selectedMove = bestMove;
+		m_lastMoveFromBook = true;
+		m_journalPending = false;
+		updatePrincipalVariation(0, bestMove);
+		finishSearchStats(searchStart);
+		return bestMove;
+	}
+
+	uint64_t positionHash = 0;
+	if ((m_analysisCache.isOpen() || m_analysisJournal.is_open()) && !possibleMoves.empty()) {
+		positionHash = hashPosition(position);
+	}
+	// A deeper search of the same position that gets stopped leaves the last finished one pending
+	if (m_journalPending && m_journalRecord.hash != positionHash) m_journalPending = false;
+
+	// Reuse a previous search of this position if it went at least as deep.
+	// The stored move must still be one of our legal (and not undoing) moves.
+	if (const AnalysisRecord* cached = m_analysisCache.find(positionHash)) {
+		if (cached->depth >= depth) {
+			for (const auto& move : possibleMoves) {
+				if (move.pieceIndex == cached->pieceIndex &&
+					move.fromRow == cached->fromRow && move.fromCol == cached->fromCol &&
+					move.toRow == cached->toRow && move.toCol == cached->toCol) {
+					m_bestScore = cached->score;
+					m_selectedMove = move;
+					m_lastMoveCached = true;
+					m_lastSearchDepth = cached->depth;
+					m_journalPending = false;
+					updatePrincipalVariation(0, move);
+					finishSearchStats(searchStart);
+					return move;
+				}
+			}
+		}
+	}
+
+	resetPatterns(position);
+	m_searchHistory = history;
+
+	// Boards up to 8x8 fit one mask word per side, so the search moves a far smaller position around
+	if (position.gridSize <= SmallPosition::MAX_GRID_SIZE) {
+		SmallPosition small = SmallPosition::from(position);
+		bestScore = searchRoot(small, possibleMoves, depth, bestMove);
+	} else {
+		bestScore = searchRoot(position, possibleMoves, depth, bestMove);
+	}
+
+	m_bestScore = bestScore;
+	m_selectedMove = bestMove;
+	finishSearchStats(searchStart);
+
+	// Kept until journalLastDecision, so iterative callers journal only their final depth
+	if (m_analysisJournal.is_open() && bestMove.pieceIndex >= 0 && !m_stopped) {
+		AnalysisRecord& record = m_journalRecord;
+		record = {};
+		record.hash = positionHash;
+		record.score = bestScore;
+		record.depth = static_cast<uint8_t>(depth);
+		record.pieceIndex = static_cast<int8_t>(bestMove.pieceIndex);
+		record.fromRow = static_cast<int8_t>(bestMove.fromRow);
+		record.fromCol = static_cast<int8_t>(bestMove.fromCol);
+		record.toRow = static_cast<int8_t>(bestMove.toRow);
+		record.toCol = static_cast<int8_t>(bestMove.toCol);
+		m_journalPending = true;
+	}
+
+	return bestMove;
+}
+
+template <class SearchPosition>
+int AI::searchRoot(SearchPosition& position, const vector<Move>& possibleMoves, int depth, Move& bestMove)
+{
+	int bestScore = INT_MIN;
+	int alpha = INT_MIN;
+	const int beta = INT_MAX;
+	const int side = position.sideToMove();
+
 	for (const auto& move : possibleMoves) {
-		Piece* piece = &p2Pieces[move.pieceIndex];
-		applyMove(boardCopy, piece, move.fromRow, move.fromCol, move.toRow, move.toCol);
+		applyMove(position, move);
+		const int toCell = move.toRow * position.gridSize + move.toCol;
 
 		// Check if this move wins immediately
-		if (hasWon(boardCopy, false)) {
+		if (Rules::completesLine(position, side, toCell)) {
 			bestMove = move;
 			bestScore = WINNING_SCORE;
-			undoMove(boardCopy, piece, move.fromRow, move.fromCol, move.toRow, move.toCol);
+			m_rootMoves.push_back({ move, bestScore, true });
+			m_pvLength[1] = 0;
+			updatePrincipalVariation(0, move);
+			undoMove(position, move);
 			break;
 		}
 
-		int score = minimax(boardCopy, p2Pieces, p1Pieces, gridSize, depth - 1, false, isPlacementPhase, alpha, beta);
+		int score = minimax(position, depth - 1, false, alpha, beta, toCell);
 
 		// Undo the move
-		undoMove(boardCopy, piece, move.fromRow, move.fromCol, move.toRow, move.toCol);
+		undoMove(position, move);
+		if (m_stopped) break;
 
+		// Only a move that raised alpha got an exact score; the rest failed low
+		m_rootMoves.push_back({ move, score, score > alpha });
 		if (score > bestScore) {
 			bestScore = score;
 			bestMove = move;
+			updatePrincipalVariation(0, move);
 			alpha = max(alpha, bestScore);
 		}
 	}
+	return bestScore;
+}
 
-	m_bestScore = bestScore;
-	m_selectedMove = bestMove;
+Move AI::findBestMoveWithinBudget(const Position& position, uint64_t nodeBudget, bool useRandomPlacement, const Move& lastMove,
+	Strategy strategy, const PositionHistory& history)
+{
+	const auto start = std::chrono::steady_clock::now();
+	const uint64_t savedLimit = m_nodeLimit;
+	uint64_t nodesUsed = 0;
+
+	// Results of the deepest search that finished, put back after a stopped one
+	Move bestMove;
+	int bestScore = 0;
+	int searchDepth = 0;
+	int movesConsidered = 0;
+	bool fromBook = false;
+	bool cached = false;
+	SearchStats stats;
+	vector<RootMove> rootMoves;
+
+	// Heap use of every iteration, stopped ones included, to match nodesUsed
+	uint64_t allocations = 0;
+	uint64_t allocatedBytes = 0;
+	uint64_t peakAllocatedBytes = 0;
+
+	for (int depth = 1; depth <= SearchStats::MAX_PLY && nodesUsed < nodeBudget; ++depth) {
+		m_nodeLimit = nodeBudget - nodesUsed;
+		const Move move = findBestMove(position, depth, useRandomPlacement, lastMove, strategy, history);
+		nodesUsed += m_nodesSearched;
+		allocations += m_stats.allocations;
+		allocatedBytes += m_stats.allocatedBytes;
+		peakAllocatedBytes = std::max(peakAllocatedBytes, m_stats.peakAllocatedBytes);
+		if (m_stopped) break;
+
+		bestMove = move;
+		bestScore = m_bestScore;
+		searchDepth = m_lastSearchDepth;
+		movesConsidered = m_movesConsidered;
+		fromBook = m_lastMoveFromBook;
+		cached = m_lastMoveCached;
+		stats = m_stats;
+		rootMoves = m_rootMoves;
+
+		// Book, cache and random moves do not change with depth, and neither does a
+		// tree whose every line ended before the horizon
+		if (fromBook || cached || m_nodesSearched == 0 || m_stats.maxDepthReached < depth) break;
+	}
+	m_nodeLimit = savedLimit;
+
+	const bool stopRequested = m_stopFlag && m_stopFlag->load(std::memory_order_relaxed);
+	if (bestMove.pieceIndex < 0 && !stopRequested) {
+		// Even depth 1 ran out of budget; it is too shallow to skip
+		m_nodeLimit = UINT64_MAX;
+		const Move move = findBestMove(position, 1, useRandomPlacement, lastMove, strategy, history);
+		m_nodeLimit = savedLimit;
+		m_nodesSearched += nodesUsed;
+		m_stats.nodes = m_nodesSearched;
+		m_stats.allocations += allocations;
+		m_stats.allocatedBytes += allocatedBytes;
+		m_stats.peakAllocatedBytes = std::max(m_stats.peakAllocatedBytes, peakAllocatedBytes);
+		m_stats.allocationsPerNode = m_stats.nodes > 0 ? static_cast<double>(m_stats.allocations) / m_stats.nodes : 0.0;
+		m_stats.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		m_stats.nodesPerSecond = m_stats.elapsedMs > 0.0 ? m_stats.nodes * 1000.0 / m_stats.elapsedMs : 0.0;
+		return move;
+	}
 
+	m_selectedMove = bestMove;
+	m_bestScore = bestScore;
+	m_lastSearchDepth = searchDepth;
+	m_movesConsidered = movesConsidered;
+	m_lastMoveFromBook = fromBook;
+	m_lastMoveCached = cached;
+	m_rootMoves = rootMoves;
+	m_stopped = bestMove.pieceIndex < 0;
+	m_nodesSearched = nodesUsed;
+	m_stats = stats;
+	m_stats.nodes = nodesUsed;
+	m_stats.allocations = allocations;
+	m_stats.allocatedBytes = allocatedBytes;
+	m_stats.peakAllocatedBytes = peakAllocatedBytes;
+	m_stats.allocationsPerNode = nodesUsed > 0 ? static_cast<double>(allocations) / nodesUsed : 0.0;
+	m_stats.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	m_stats.nodesPerSecond = m_stats.elapsedMs > 0.0 ? nodesUsed * 1000.0 / m_stats.elapsedMs : 0.0;
 	return bestMove;
 }
 
-int AI::minimax(vector<vector<Piece*>>& board, vector<Piece>& p2Pieces, 
-	vector<Piece>& p1Pieces, int gridSize, int depth, bool isMaximizing, 
-	bool isPlacementPhase, int alpha, int beta)
+bool AI::openAnalysisCache(const string& path)
+{
+	return m_analysisCache.open(path);
+}
+
+bool AI::openOpeningBook(const string& path)
+{
+	return m_openingBook.open(path);
+}
+
+bool AI::openAnalysisJournal(const string& path)
+{
+	m_analysisJournal.close();
+	m_analysisJournal.open(path, ios::binary | ios::app);
+	return m_analysisJournal.is_open();
+}
+
+void AI::journalLastDecision()
+{
+	if (!m_journalPending) return;
+	m_journalPending = false;
+	// Left to the stream's buffer; the file is complete once the AI is destroyed
+	m_analysisJournal.write(reinterpret_cast<const char*>(&m_journalRecord), sizeof(m_journalRecord));
+}
+
+int AI::verifyEvaluationKernels(ReferenceEvaluation reference, int positions)
+{
+	const Strategy savedStrategy = m_strategy;
+	const Strategy strategies[] = { Strategy::Balanced, Strategy::FavorDiagonal, Strategy::FavorCenter,
+		Strategy::FavorEdges, Strategy::Aggressive, Strategy::Defensive };
+	const BitboardEvaluator::Kernel kernels[] = { BitboardEvaluator::Kernel::Scalar,
+		BitboardEvaluator::Kernel::SSE41, BitboardEvaluator::Kernel::AVX2 };
+	mt19937 rng(12345);
+	int mismatches = 0;
+
+	for (Strategy strategy : strategies) {
+		m_strategy = strategy;
+		for (int variant = 0; variant < Variants::count(); ++variant) {
+			const int gridSize = Variants::get(variant).gridSize;
+			setupLines(gridSize);
+			Position position = {};
+			position.gridSize = static_cast<int8_t>(gridSize);
+
+			for (int i = 0; i < positions; ++i) {
+				BoardMask masks[2] = {};
+				for (int cell = 0; cell < gridSize * gridSize; ++cell) {
+					// Roughly a third of the cells each: empty, Player 1, Player 2 (piece 0 of that side)
+					int owner = static_cast<int>(rng() % 3);
+					position.cells[cell] = owner == 0 ? Position::NONE : static_cast<int8_t>((owner - 1) * Position::MAX_PIECES);
+					if (owner != 0) masks[owner - 1].set(cell);
+				}
+
+				for (bool isPlacementPhase : { false, true }) {
+					position.placementPhase = isPlacementPhase;
+					int expected = reference(position, strategy);
+					if (evaluateBoard(position) != expected) ++mismatches;
+					if (m_bitboardEvaluator.evaluateWide(masks[0], masks[1], isPlacementPhase) != expected) ++mismatches;
+					if (gridSize > BitboardEvaluator::MAX_GRID_SIZE) continue;
+
+					for (auto kernel : kernels) {
+						if (!BitboardEvaluator::isSupported(kernel)) continue;
+						if (m_bitboardEvaluator.evaluateWith(kernel, masks[0].words[0], masks[1].words[0], isPlacementPhase) != expected) {
+							++mismatches;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	m_strategy = savedStrategy;
+	return mismatches;
+}
+
+bool AI::probeOpeningBook(const Position& position, const vector<Move>& possibleMoves, Move& bookMove)
+{
+	if (!m_openingBook.isOpen() || position.pieceCount[position.sideToMove()] == 0) return false;
+
+	const int gridSize = position.gridSize;
+	vector<int> cells(gridSize * gridSize, OpeningBook::EMPTY_CELL);
+	for (int cell = 0; cell < gridSize * gridSize; ++cell) {
+		if (!position.isEmpty(cell)) {
+			cells[cell] = OpeningBook::encodeCell(position.isPlayer1At(cell), position.typeAt(cell));
+		}
+	}
+
+	int symmetry = 0;
+	uint64_t key = OpeningBook::canonicalKey(cells, gridSize, position.player1ToMove, symmetry);
+	const OpeningBookRecord* record = m_openingBook.find(key);
+	if (!record) return false;
+
+	const OpeningBookMove& stored = record->moves[static_cast<int>(m_strategy)];
+	if (stored.pieceType < 0) return false;
+
+	// Book moves are stored on the canonical board, so map the target back onto ours
+	int cell = OpeningBook::inverseTransformCell(stored.cell, gridSize, symmetry);
+	int toRow = cell / gridSize;
+	int toCol = cell % gridSize;
+	const int8_t* pieceTypes = position.pieceTypes[position.sideToMove()];
+
+	for (const auto& move : possibleMoves) {
+		if (move.toRow == toRow && move.toCol == toCol && pieceTypes[move.pieceIndex] == stored.pieceType) {
+			bookMove = move;
+			return true;
+		}
+	}
+	return false;
+}
+
+uint64_t AI::hashPosition(const Position& position)
 {
+	uint64_t hash = Zobrist::gridKey(position.gridSize) ^ Zobrist::strategyKey(static_cast<int>(m_strategy));
+	if (position.player1ToMove) hash ^= Zobrist::player1ToMoveKey();
+	if (position.placementPhase) hash ^= Zobrist::placementKey();
+	return hash ^ position.boardKey;
+}
+
+template <class SearchPosition>
+int AI::minimax(SearchPosition& position, int depth, bool isMaximizing, int alpha, int beta, int lastCell)
+{
+	// A stopped search unwinds at once; findBestMove flags its result as unusable
+	if ((m_stopFlag && m_stopFlag->load(std::memory_order_relaxed)) || m_nodesSearched >= m_nodeLimit) {
+		m_stopped = true;
+		return 0;
+	}
+
+	++m_nodesSearched;
+	const int ply = m_rootDepth - depth;
+	if (ply < SearchStats::MAX_PLY) {
+		++m_stats.plyNodes[ply];
+		m_pvLength[ply] = 0;
+	}
+	m_stats.maxDepthReached = max(m_stats.maxDepthReached, ply);
+
 	// Terminal conditions
+	if (m_searchHistory.isRepetitionDraw(position.repetitionKey())) {
+		return DRAW_SCORE;
+	}
+
 	if (depth == 0) {
-		return evaluateBoard(board, isPlacementPhase);
+		++m_stats.leafEvaluations;
+		return evaluateLeaf(position);
 	}
 
-	// Check for win conditions
-	if (hasWon(board, false)) {
-		return WINNING_SCORE + depth; // Prefer faster wins
+	// Only the side that just moved can have won, and only through the cell it moved to
+	// (the searching side moved last when minimizing)
+	if (Rules::completesLine(position, Position::sideOf(!position.player1ToMove), lastCell)) {
+		return isMaximizing ? LOSING_SCORE - depth // Prefer slower losses
+			: WINNING_SCORE + depth; // Prefer faster wins
 	}
-	if (hasWon(board, true)) {
-		return LOSING_SCORE - depth; // Prefer slower losses
+
+	// A side whose pieces are all blocked is scored as the position stands, never with the
+	// INT_MIN/INT_MAX of an empty loop
+	vector<Move> moves = generateMoves(position);
+	if (moves.empty()) {
+		++m_stats.leafEvaluations;
+		return evaluateLeaf(position);
 	}
 
 	if (isMaximizing) {
-		// AI's turn (Player 2)
+		// Searching side's turn
 		int maxEval = INT_MIN;
-		vector<Move> moves = generateMoves(board, p2Pieces, gridSize, isPlacementPhase);
 
 		for (const auto& move : moves) {
-			Piece* piece = &p2Pieces[move.pieceIndex];
-			applyMove(board, piece, move.fromRow, move.fromCol, move.toRow, move.toCol);
+			applyMove(position, move);
 
-			int eval = minimax(board, p2Pieces, p1Pieces, gridSize, depth - 1, false, isPlacementPhase, alpha, beta);
+			int eval = minimax(position, depth - 1, false, alpha, beta, move.toRow * position.gridSize + move.toCol);
 
-			undoMove(board, piece, move.fromRow, move.fromCol, move.toRow, move.toCol);
+			undoMove(position, move);
+			if (m_stopped) break;
 
-			maxEval = max(maxEval, eval);
+			if (eval > maxEval) {
+				maxEval = eval;
+				updatePrincipalVariation(ply, move);
+			}
 			alpha = max(alpha, eval);
 
 			// Alpha-beta pruning
 			if (beta <= alpha) {
+				recordCutoff(ply, &move == &moves.front());
 				break;
 			}
 		}
@@ -133,21 +464,24 @@ int AI::minimax(vector<vector<Piece*>>& board, vector<Piece>& p2Pieces,
 		return maxEval;
 	} else {
 		int minEval = INT_MAX;
-		vector<Move> moves = generateMoves(board, p1Pieces, gridSize, isPlacementPhase);
 
 		for (const auto& move : moves) {
-			Piece* piece = &p1Pieces[move.pieceIndex];
-			applyMove(board, piece, move.fromRow, move.fromCol, move.toRow, move.toCol);
+			applyMove(position, move);
 
-			int eval = minimax(board, p2Pieces, p1Pieces, gridSize, depth - 1, true, isPlacementPhase, alpha, beta);
+			int eval = minimax(position, depth - 1, true, alpha, beta, move.toRow * position.gridSize + move.toCol);
 
-			undoMove(board, piece, move.fromRow, move.fromCol, move.toRow, move.toCol);
+			undoMove(position, move);
+			if (m_stopped) break;
 
-			minEval = min(minEval, eval);
+			if (eval < minEval) {
+				minEval = eval;
+				updatePrincipalVariation(ply, move);
+			}
 			beta = min(beta, eval);
 
 			// Alpha-beta pruning
 			if (beta <= alpha) {
+				recordCutoff(ply, &move == &moves.front());
 				break;
 			}
 		}
@@ -156,256 +490,370 @@ int AI::minimax(vector<vector<Piece*>>& board, vector<Piece>& p2Pieces,
 	}
 }
 
-int AI::evaluateBoard(const vector<vector<Piece*>>& board, bool isPlacementPhase)
+void AI::updatePrincipalVariation(int ply, const Move& move)
 {
-	int score = 0;
-	int gridSize = static_cast<int>(board.size());
-	
-	// Strategy-based multipliers
-	int centerMultiplier = 1;
-	int edgeMultiplier = 0;
-	int horizontalMultiplier = 10;
-	int verticalMultiplier = 10;
-	int diagonalMultiplier = 10;
-	int offenseMultiplier = 1;
-	int defenseMultiplier = 1;
-	
+	if (ply >= SearchStats::MAX_PLY) return;
+
+	// Row ply + 1 holds the reply line just searched below this move
+	m_pvTable[ply][0] = move;
+	int length = 1;
+	if (ply + 1 < SearchStats::MAX_PLY) {
+		for (int i = 0; i < m_pvLength[ply + 1]; ++i) {
+			m_pvTable[ply][length++] = m_pvTable[ply + 1][i];
+		}
+	}
+	m_pvLength[ply] = length;
+}
+
+void AI::recordCutoff(int ply, bool firstMove)
+{
+	++m_stats.betaCutoffs;
+	if (firstMove) ++m_stats.firstMoveCutoffs;
+	if (ply < SearchStats::MAX_PLY) ++m_stats.plyCutoffs[ply];
+}
+
+void AI::finishSearchStats(std::chrono::steady_clock::time_point start)
+{
+	const AllocationTracker::Counts heap = AllocationTracker::end();
+	m_stats.allocations = heap.allocations;
+	m_stats.allocatedBytes = heap.bytes;
+	m_stats.peakAllocatedBytes = heap.peakBytes;
+	m_stats.allocationsPerNode = m_nodesSearched > 0 ? static_cast<double>(heap.allocations) / m_nodesSearched : 0.0;
+
+	m_stats.nodes = m_nodesSearched;
+	m_stats.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	m_stats.nodesPerSecond = m_stats.elapsedMs > 0.0 ? m_stats.nodes * 1000.0 / m_stats.elapsedMs : 0.0;
+	m_stats.effectiveBranchingFactor = m_stats.maxDepthReached > 0
+		? std::pow(static_cast<double>(m_stats.nodes), 1.0 / m_stats.maxDepthReached) : 0.0;
+
+	m_stats.principalVariationLength = m_pvLength[0];
+	for (int i = 0; i < m_pvLength[0]; ++i) {
+		m_stats.principalVariation[i] = m_pvTable[0][i];
+	}
+}
+
+EvalWeights AI::weightsFor(Strategy strategy, bool isPlacementPhase)
+{
+	// center, edge, horizontal, vertical, diagonal, offense, defense
+	EvalWeights weights = { 1, 0, 10, 10, 10, 1, 1 };
+
 	// Adjust multipliers based on strategy
-	switch (m_strategy) {
+	switch (strategy) {
 		case Strategy::FavorCenter:
-			centerMultiplier = isPlacementPhase ? 8 : 3;
+			weights.center = isPlacementPhase ? 8 : 3;
 			break;
 		case Strategy::FavorEdges:
-			centerMultiplier = 0;
-			edgeMultiplier = isPlacementPhase ? 8 : 2;
+			weights.center = 0;
+			weights.edge = isPlacementPhase ? 8 : 2;
 			break;
 		case Strategy::FavorDiagonal:
-			diagonalMultiplier = 20;
-			horizontalMultiplier = 8;
-			verticalMultiplier = 8;
+			weights.diagonal = 20;
+			weights.horizontal = 8;
+			weights.vertical = 8;
 			break;
 		case Strategy::Aggressive:
-			offenseMultiplier = 2;
-			defenseMultiplier = 1;
-			centerMultiplier = isPlacementPhase ? 3 : 1;
+			weights.offense = 2;
+			weights.defense = 1;
+			weights.center = isPlacementPhase ? 3 : 1;
 			break;
 		case Strategy::Defensive:
-			offenseMultiplier = 1;
-			defenseMultiplier = 2;
-			centerMultiplier = isPlacementPhase ? 2 : 1;
+			weights.offense = 1;
+			weights.defense = 2;
+			weights.center = isPlacementPhase ? 2 : 1;
 			break;
 		case Strategy::Balanced:
 		default:
-			centerMultiplier = isPlacementPhase ? 3 : 1;
+			weights.center = isPlacementPhase ? 3 : 1;
 			break;
 	}
-	
-	for (int row = 0; row < gridSize; ++row) {
-		for (int col = 0; col < gridSize; ++col) {
-			if (board[row][col]) {
-				int lineCount = 0;
-				bool isEdge = (row == 0 || row == gridSize - 1 || col == 0 || col == gridSize - 1);
-				
-				if (!board[row][col]->isPlayer1())
-				{
-					// Position scoring
-					score += scoreCloserToCenter(row, col, gridSize) * centerMultiplier;
-					if (isEdge) score += 5 * edgeMultiplier;
-					
-					// Horizontal
-					lineCount = countInLine(board, row, col, 0, 1, false);
-					if (lineCount >= 3) score += lineCount * lineCount * horizontalMultiplier * 15 / 10 * offenseMultiplier;
-					else score += lineCount * lineCount * horizontalMultiplier * offenseMultiplier;
-
-					// Vertical
-					lineCount = countInLine(board, row, col, 1, 0, false);
-					if (lineCount >= 3) score += lineCount * lineCount * verticalMultiplier * 15 / 10 * offenseMultiplier;
-					else score += lineCount * lineCount * verticalMultiplier * offenseMultiplier;
-
-					// Diagonal (\)
-					lineCount = countInLine(board, row, col, 1, 1, false);
-					if (lineCount >= 3) score += lineCount * lineCount * diagonalMultiplier * 15 / 10 * offenseMultiplier;
-					else score += lineCount * lineCount * diagonalMultiplier * offenseMultiplier;
-
-					// Diagonal (/)
-					lineCount = countInLine(board, row, col, 1, -1, false);
-					if (lineCount >= 3) score += lineCount * lineCount * diagonalMultiplier * 15 / 10 * offenseMultiplier;
-					else score += lineCount * lineCount * diagonalMultiplier * offenseMultiplier;
-				}
-				else
-				{
-					// Position scoring
-					score -= scoreCloserToCenter(row, col, gridSize) * centerMultiplier;
-					if (isEdge) score -= 5 * edgeMultiplier;
-					
-					// Horizontal
-					lineCount = countInLine(board, row, col, 0, 1, true);
-					if (lineCount >= 3) score -= lineCount * lineCount * horizontalMultiplier * 2 * defenseMultiplier;
-					else score -= lineCount * lineCount * horizontalMultiplier * defenseMultiplier;
-
-					// Vertical
-					lineCount = countInLine(board, row, col, 1, 0, true);
-					if (lineCount >= 3) score -= lineCount * lineCount * verticalMultiplier * 2 * defenseMultiplier;
-					else score -= lineCount * lineCount * verticalMultiplier * defenseMultiplier;
-
-					// Diagonal (\)
-					lineCount = countInLine(board, row, col, 1, 1, true);
-					if (lineCount >= 3) score -= lineCount * lineCount * diagonalMultiplier * 2 * defenseMultiplier;
-					else score -= lineCount * lineCount * diagonalMultiplier * defenseMultiplier;
-
-					// Diagonal (/)
-					lineCount = countInLine(board, row, col, 1, -1, true);
-					if (lineCount >= 3) score -= lineCount * lineCount * diagonalMultiplier * 2 * defenseMultiplier;
-					else score -= lineCount * lineCount * diagonalMultiplier * defenseMultiplier;
+	return weights;
+}
+
+const LinePatterns& AI::patternsFor(Strategy strategy)
+{
+	// Line multipliers do not depend on the phase, so one table per strategy is enough
+	static const LinePatterns tables[] = {
+		LinePatterns(weightsFor(Strategy::Balanced, true)),
+		LinePatterns(weightsFor(Strategy::FavorDiagonal, true)),
+		LinePatterns(weightsFor(Strategy::FavorCenter, true)),
+		LinePatterns(weightsFor(Strategy::FavorEdges, true)),
+		LinePatterns(weightsFor(Strategy::Aggressive, true)),
+		LinePatterns(weightsFor(Strategy::Defensive, true))
+	};
+	return tables[static_cast<int>(strategy)];
+}
+
+void AI::setupLines(int gridSize)
+{
+	m_patterns = &patternsFor(m_strategy);
+	m_lineGridSize = gridSize;
+	m_lineCount = 0;
+
+	// Longer lines have too many patterns to tabulate; those boards are scored from bitboards alone
+	m_useLinePatterns = gridSize <= LinePatterns::MAX_LINE_LENGTH;
+
+	// Number every row, column and diagonal, and record where each cell sits in its four lines
+	const int directions[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+	const LinePatterns::Direction kinds[4] = {
+		LinePatterns::Horizontal, LinePatterns::Vertical, LinePatterns::Diagonal, LinePatterns::Diagonal };
+
+	for (int d = 0; d < 4 && m_useLinePatterns; ++d) {
+		int dRow = directions[d][0];
+		int dCol = directions[d][1];
+		for (int row = 0; row < gridSize; ++row) {
+			for (int col = 0; col < gridSize; ++col) {
+				int prevRow = row - dRow;
+				int prevCol = col - dCol;
+				if (prevRow >= 0 && prevRow < gridSize && prevCol >= 0 && prevCol < gridSize) continue; // not a line start
+
+				int line = m_lineCount++;
+				m_lineDirections[line] = kinds[d];
+				int r = row;
+				int c = col;
+				for (int index = 0; r >= 0 && r < gridSize && c >= 0 && c < gridSize; ++index) {
+					m_cellLines[r * gridSize + c][d] = { line, LinePatterns::power(index) };
+					r += dRow;
+					c += dCol;
 				}
 			}
 		}
 	}
 
-	return score;
+	for (int phase = 0; phase < 2; ++phase) {
+		EvalWeights weights = weightsFor(m_strategy, phase == 1);
+		for (int row = 0; row < gridSize; ++row) {
+			for (int col = 0; col < gridSize; ++col) {
+				bool isEdge = (row == 0 || row == gridSize - 1 || col == 0 || col == gridSize - 1);
+				m_cellWeights[phase][row * gridSize + col] = scoreCloserToCenter(row, col, gridSize) * weights.center
+					+ (isEdge ? 5 * weights.edge : 0);
+			}
+		}
+	}
+
+	// Only the AVX2 kernel beats the pattern tables at the leaves; the others serve batch scoring
+	m_useBitboards = gridSize <= BitboardEvaluator::MAX_GRID_SIZE
+		&& m_bitboardEvaluator.getKernel() == BitboardEvaluator::Kernel::AVX2;
+	const int* const cellWeights[2] = { m_cellWeights[0], m_cellWeights[1] };
+	m_bitboardEvaluator.configure(gridSize, weightsFor(m_strategy, false), cellWeights);
 }
 
-int AI::countInLine(const vector<vector<Piece*>>& board, int row, int col, int dRow, int dCol, bool isPlayer1)
+void AI::resetPatterns(const Position& position)
 {
-	int count = 1;
-	int gridSize = static_cast<int>(board.size());
+	const int gridSize = position.gridSize;
+	setupLines(gridSize);
+	for (int line = 0; line < m_lineCount; ++line) m_lineCodes[line] = 0;
+	m_positionScore[0] = 0;
+	m_positionScore[1] = 0;
+	if (!m_useLinePatterns) return;
+
+	for (int cell = 0; cell < gridSize * gridSize; ++cell) {
+		if (!position.isEmpty(cell)) {
+			updatePatterns(cell, position.isPlayer1At(cell), 1);
+		}
+	}
+}
 
-	// Count in positive direction
-	int r = row + dRow;
-	int c = col + dCol;
-	while (r >= 0 && r < gridSize && c >= 0 && c < gridSize && board[r][c] && board[r][c]->isPlayer1() == isPlayer1) {
-		count++;
-		r += dRow;
-		c += dCol;
+void AI::updatePatterns(int cell, bool isPlayer1, int sign)
+{
+	if (!m_useLinePatterns) return;
+
+	const int digit = isPlayer1 ? LinePatterns::PLAYER1 : LinePatterns::PLAYER2;
+	for (const auto& cellLine : m_cellLines[cell]) {
+		m_lineCodes[cellLine.line] += sign * digit * cellLine.power;
 	}
 
-	// Count in negative direction
-	r = row - dRow;
-	c = col - dCol;
-	while (r >= 0 && r < gridSize && c >= 0 && c < gridSize && board[r][c] && board[r][c]->isPlayer1() == isPlayer1) {
-		count++;
-		r -= dRow;
-		c -= dCol;
+	// Player 2's pieces score positively, Player 1's negatively
+	const int side = isPlayer1 ? -sign : sign;
+	m_positionScore[0] += side * m_cellWeights[0][cell];
+	m_positionScore[1] += side * m_cellWeights[1][cell];
+}
+
+int AI::evaluatePatterns(bool isPlacementPhase) const
+{
+	int score = m_positionScore[isPlacementPhase ? 1 : 0];
+	for (int line = 0; line < m_lineCount; ++line) {
+		score += m_patterns->score(m_lineDirections[line], m_lineCodes[line]);
 	}
+	return score;
+}
 
-	return count;
+template <class SearchPosition>
+int AI::evaluateLeaf(const SearchPosition& position) const
+{
+	// Every evaluator scores from Player 2's view
+	const bool isPlacementPhase = position.placementPhase;
+	if (!m_useLinePatterns) {
+		return m_perspective * m_bitboardEvaluator.evaluateWide(toBoardMask(position.occupancy[0]), toBoardMask(position.occupancy[1]), isPlacementPhase);
+	}
+	if (m_useBitboards) {
+		return m_perspective * m_bitboardEvaluator.evaluate(position.occupancy[0].words[0], position.occupancy[1].words[0], isPlacementPhase);
+	}
+	return m_perspective * evaluatePatterns(isPlacementPhase);
 }
 
-vector<Move> AI::generateMoves(const vector<vector<Piece*>>& board, vector<Piece>& playerPieces, 
-	int gridSize, bool isPlacementPhase)
+int AI::evaluateBoard(const Position& position)
 {
-	vector<Move> moves;
+	int gridSize = position.gridSize;
+	if (m_patterns != &patternsFor(m_strategy) || m_lineGridSize != gridSize) {
+		setupLines(gridSize);
+	}
 
-	if (isPlacementPhase) {
-		// During placement, find unplaced pieces and empty cells
-		vector<pair<int, int>> emptyCells = getEmptyCells(board, gridSize);
+	if (!m_useLinePatterns) return evaluateLongLines(position);
 
-		for (int i = 0; i < playerPieces.size(); ++i) {
-			if (playerPieces[i].getGridRow() < 0) {
-				for (const auto& cell : emptyCells) {
-					moves.push_back(Move(i, -1, -1, cell.first, cell.second));
-				}
-			}
-		}
-	} else {
-		for (int i = 0; i < playerPieces.size(); ++i) {
-			int fromRow = playerPieces[i].getGridRow();
-			int fromCol = playerPieces[i].getGridCol();
-
-			if (fromRow >= 0 && fromCol >= 0) {
-				auto validMoves = playerPieces[i].getValidMoves(board, gridSize);
-				for (const auto& target : validMoves) {
-					moves.push_back(Move(i, fromRow, fromCol, target.first, target.second));
-				}
-			}
+	int lineCodes[MAX_LINES] = {};
+	int score = 0;
+	const int* cellWeights = m_cellWeights[position.placementPhase ? 1 : 0];
+
+	for (int cell = 0; cell < gridSize * gridSize; ++cell) {
+		if (position.isEmpty(cell)) continue;
+
+		bool isPlayer1 = position.isPlayer1At(cell);
+		int digit = isPlayer1 ? LinePatterns::PLAYER1 : LinePatterns::PLAYER2;
+		for (const auto& cellLine : m_cellLines[cell]) {
+			lineCodes[cellLine.line] += digit * cellLine.power;
 		}
+		score += isPlayer1 ? -cellWeights[cell] : cellWeights[cell];
 	}
 
-	return moves;
+	for (int line = 0; line < m_lineCount; ++line) {
+		score += m_patterns->score(m_lineDirections[line], lineCodes[line]);
+	}
+	return score;
 }
 
-void AI::applyMove(vector<vector<Piece*>>& board, Piece* piece, int fromRow, int fromCol, int toRow, int toCol)
+int AI::evaluateLongLines(const Position& position) const
 {
-	if (fromRow >= 0 && fromCol >= 0) {
-		board[fromRow][fromCol] = nullptr;
+	const int gridSize = position.gridSize;
+	const EvalWeights weights = weightsFor(m_strategy, position.placementPhase);
+	const int* cellWeights = m_cellWeights[position.placementPhase ? 1 : 0];
+	int score = 0;
+
+	for (int cell = 0; cell < gridSize * gridSize; ++cell) {
+		if (!position.isEmpty(cell)) score += position.isPlayer1At(cell) ? -cellWeights[cell] : cellWeights[cell];
 	}
-	board[toRow][toCol] = piece;
-	piece->setGridPosition(toRow, toCol);
-}
 
-void AI::undoMove(vector<vector<Piece*>>& board, Piece* piece, int fromRow, int fromCol, int toRow, int toCol)
-{
-	board[toRow][toCol] = nullptr;
-	if (fromRow >= 0 && fromCol >= 0) {
-		board[fromRow][fromCol] = piece;
+	// Walk every row, column and diagonal from its first cell and score it directly
+	const int directions[4][3] = { { 0, 1, weights.horizontal }, { 1, 0, weights.vertical },
+		{ 1, 1, weights.diagonal }, { 1, -1, weights.diagonal } };
+	int digits[Position::MAX_GRID_SIZE];
+	for (const auto& direction : directions) {
+		const int dRow = direction[0];
+		const int dCol = direction[1];
+		for (int row = 0; row < gridSize; ++row) {
+			for (int col = 0; col < gridSize; ++col) {
+				int prevRow = row - dRow;
+				int prevCol = col - dCol;
+				if (prevRow >= 0 && prevRow < gridSize && prevCol >= 0 && prevCol < gridSize) continue; // not a line start
+
+				int length = 0;
+				for (int r = row, c = col; r >= 0 && r < gridSize && c >= 0 && c < gridSize; r += dRow, c += dCol) {
+					int cell = r * gridSize + c;
+					digits[length++] = position.isEmpty(cell) ? LinePatterns::EMPTY
+						: position.isPlayer1At(cell) ? LinePatterns::PLAYER1 : LinePatterns::PLAYER2;
+				}
+				score += LinePatterns::scoreLine(digits, length, direction[2], weights);
+			}
+		}
 	}
-	piece->setGridPosition(fromRow, fromCol);
+	return score;
 }
 
-bool AI::hasWon(const vector<vector<Piece*>>& board, bool isPlayer1)
+template <class SearchPosition>
+vector<Move> AI::generateMoves(const SearchPosition& position)
 {
-	// Check horizontal
-	for (int row = 0; row < 5; ++row) {
-		for (int col = 0; col <= 1; ++col) {
-			if (board[row][col] && board[row][col]->isPlayer1() == isPlayer1 &&
-				board[row][col + 1] && board[row][col + 1]->isPlayer1() == isPlayer1 &&
-				board[row][col + 2] && board[row][col + 2]->isPlayer1() == isPlayer1 &&
-				board[row][col + 3] && board[row][col + 3]->isPlayer1() == isPlayer1) {
-				return true;
+	vector<Move> moves;
+	const int side = position.sideToMove();
+	const int gridSize = position.gridSize;
+	const int pieceCount = position.pieceCount[side];
+
+	if (position.placementPhase) {
+		// During placement, pair every unplaced piece with every empty cell (near the pieces on large boards)
+		const int radius = Variants::get(position.variant).placementRadius;
+		int16_t cells[SearchPosition::MAX_CELLS];
+		int cellCount = 0;
+		if (radius > 0) {
+			const typename SearchPosition::Mask near = position.emptyCellsNear(radius);
+			for (int w = 0; w < SearchPosition::Mask::BITS / 64; ++w) {
+				for (uint64_t bits = near.words[w]; bits; bits &= bits - 1) {
+					cells[cellCount++] = static_cast<int16_t>(w * 64 + lowestBit(bits));
+				}
+			}
+		} else {
+			for (int cell = 0; cell < gridSize * gridSize; ++cell) {
+				if (position.isEmpty(cell)) cells[cellCount++] = static_cast<int16_t>(cell);
 			}
 		}
-	}
 
-	// Check vertical
-	for (int col = 0; col < 5; ++col) {
-		for (int row = 0; row <= 1; ++row) {
-			if (board[row][col] && board[row][col]->isPlayer1() == isPlayer1 &&
-				board[row + 1][col] && board[row + 1][col]->isPlayer1() == isPlayer1 &&
-				board[row + 2][col] && board[row + 2][col]->isPlayer1() == isPlayer1 &&
-				board[row + 3][col] && board[row + 3][col]->isPlayer1() == isPlayer1) {
-				return true;
+		for (int i = 0; i < pieceCount; ++i) {
+			if (position.pieceCells[side][i] != Position::NONE) continue;
+
+			for (int c = 0; c < cellCount; ++c) {
+				moves.push_back(Move(i, -1, -1, cells[c] / gridSize, cells[c] % gridSize));
 			}
 		}
-	}
-
-	// Check diagonal 
-	for (int row = 0; row <= 1; ++row) {
-		for (int col = 0; col <= 1; ++col) {
-			if (board[row][col] && board[row][col]->isPlayer1() == isPlayer1 &&
-				board[row + 1][col + 1] && board[row + 1][col + 1]->isPlayer1() == isPlayer1 &&
-				board[row + 2][col + 2] && board[row + 2][col + 2]->isPlayer1() == isPlayer1 &&
-				board[row + 3][col + 3] && board[row + 3][col + 3]->isPlayer1() == isPlayer1) {
-				return true;
+	} else {
+		int16_t targets[Position::MAX_TARGETS];
+		for (int i = 0; i < pieceCount; ++i) {
+			int from = position.pieceCells[side][i];
+			if (from == Position::NONE) continue;
+
+			int targetCount = position.getTargets(side, i, targets);
+			for (int t = 0; t < targetCount; ++t) {
+				moves.push_back(Move(i, from / gridSize, from % gridSize, targets[t] / gridSize, targets[t] % gridSize));
 			}
 		}
 	}
 
-	// Check diagonal 
-	for (int row = 0; row <= 1; ++row) {
-		for (int col = 3; col < 5; ++col) {
-			if (board[row][col] && board[row][col]->isPlayer1() == isPlayer1 &&
-				board[row + 1][col - 1] && board[row + 1][col - 1]->isPlayer1() == isPlayer1 &&
-				board[row + 2][col - 2] && board[row + 2][col - 2]->isPlayer1() == isPlayer1 &&
-				board[row + 3][col - 3] && board[row + 3][col - 3]->isPlayer1() == isPlayer1) {
-				return true;
-			}
-		}
+	return moves;
+}
+
+template <class SearchPosition>
+void AI::applyMove(SearchPosition& position, const Move& move)
+{
+	const int side = position.sideToMove();
+	const bool isPlayer1 = position.player1ToMove;
+	if (move.fromRow >= 0 && move.fromCol >= 0) {
+		updatePatterns(move.fromRow * m_lineGridSize + move.fromCol, isPlayer1, -1);
+	}
+	int toCell = move.toRow * m_lineGridSize + move.toCol;
+	position.putPiece(side, move.pieceIndex, toCell);
+	updatePatterns(toCell, isPlayer1, 1);
+	position.player1ToMove = !position.player1ToMove;
+
+	// Player 1 moves first once every piece is on the board; Player 2 places last, so that is also its turn by alternation
+	if (position.placementPhase && position.placedCount[0] == position.pieceCount[0] && position.placedCount[1] == position.pieceCount[1]) {
+		position.placementPhase = false;
+		position.player1ToMove = true;
+		m_searchHistory.push(position.repetitionKey());
+		return;
 	}
 
-return false;
+	// Placements add a piece, so only movement-phase positions can repeat
+	if (move.fromRow >= 0) m_searchHistory.push(position.repetitionKey());
 }
 
-vector<pair<int, int>> AI::getEmptyCells(const vector<vector<Piece*>>& board, int gridSize)
+template <class SearchPosition>
+void AI::undoMove(SearchPosition& position, const Move& move)
 {
-	vector<pair<int, int>> emptyCells;
-	for (int row = 0; row < gridSize; ++row) {
-		for (int col = 0; col < gridSize; ++col) {
-			if (board[row][col] == nullptr) {
-				emptyCells.push_back(make_pair(row, col));
-			}
-		}
+	if (move.fromRow < 0 && !position.placementPhase) {
+		// Taking back the placement that ended the placement phase; the piece's owner placed it
+		m_searchHistory.pop();
+		position.placementPhase = true;
+		position.player1ToMove = position.isPlayer1At(move.toRow * m_lineGridSize + move.toCol);
+	} else {
+		if (move.fromRow >= 0) m_searchHistory.pop();
+		position.player1ToMove = !position.player1ToMove;
+	}
+	const int side = position.sideToMove();
+	const bool isPlayer1 = position.player1ToMove;
+	updatePatterns(move.toRow * m_lineGridSize + move.toCol, isPlayer1, -1);
+	if (move.fromRow >= 0 && move.fromCol >= 0) {
+		int fromCell = move.fromRow * m_lineGridSize + move.fromCol;
+		position.putPiece(side, move.pieceIndex, fromCell);
+		updatePatterns(fromCell, isPlayer1, 1);
+	} else {
+		position.liftPiece(side, move.pieceIndex);
 	}
-	return emptyCells;
 }
 
 int AI::scoreCloserToCenter(int row, int col, int gridSize)
@@ -10,10 +10,21 @@
  */
 
 #pragma once
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <tuple>
 #include <limits>
+#include <cstdint>
+#include <fstream>
+#include <string>
 #include "Piece.h"
+#include "Position.h"
+#include "PositionHistory.h"
+#include "AnalysisCache.h"
+#include "OpeningBook.h"
+#include "LinePatterns.h"
+#include "BitboardEvaluator.h"
 
 using namespace std;
 
@@ -56,6 +67,62 @@ struct Move {
 		: pieceIndex(pi), fromRow(fr), fromCol(fc), toRow(tr), toCol(tc) {}
 };
 
+/// @brief Telemetry of one findBestMove search
+///
+/// The counters are plain increments on the search path, so they stay on in
+/// every build. A ply is the distance from the root: the root's moves lead to
+/// ply 1 and a search of depth d evaluates its leaves at ply d. Book, cache and
+/// random moves leave every counter at zero except the elapsed time, and their
+/// principal variation is the move alone. The allocation counts stay zero
+/// unless the build defines TRACK_ALLOCATIONS (see AllocationTracker.h).
+struct SearchStats {
+	/// @brief Deepest ply with its own counters and principal variation slot
+	static const int MAX_PLY = 32;
+
+	/// @brief Positions visited below the root
+	uint64_t nodes = 0;
+	/// @brief Positions scored by the evaluation at depth 0
+	uint64_t leafEvaluations = 0;
+	/// @brief Nodes whose remaining moves were pruned by alpha-beta
+	uint64_t betaCutoffs = 0;
+	/// @brief Cutoffs caused by the first move searched (a measure of move ordering)
+	uint64_t firstMoveCutoffs = 0;
+	/// @brief Positions visited at each ply
+	uint64_t plyNodes[MAX_PLY] = {};
+	/// @brief Cutoffs at each ply
+	uint64_t plyCutoffs[MAX_PLY] = {};
+	/// @brief Deepest ply visited
+	int maxDepthReached = 0;
+	/// @brief Wall time of the decision in milliseconds
+	double elapsedMs = 0.0;
+	/// @brief Nodes visited per second of wall time
+	double nodesPerSecond = 0.0;
+	/// @brief Branching factor of a uniform tree of the same depth and size
+	double effectiveBranchingFactor = 0.0;
+	/// @brief Expected line of play from the root, starting with the chosen move
+	Move principalVariation[MAX_PLY];
+	/// @brief Number of moves in the principal variation
+	int principalVariationLength = 0;
+	/// @brief Heap allocations made by the decision
+	uint64_t allocations = 0;
+	/// @brief Bytes those allocations requested
+	uint64_t allocatedBytes = 0;
+	/// @brief Most heap bytes the decision held at once
+	uint64_t peakAllocatedBytes = 0;
+	/// @brief Heap allocations per node visited
+	double allocationsPerNode = 0.0;
+};
+
+/// @brief A move of the searched position and the score the search gave it
+struct RootMove {
+	/// @brief Move of the side to move
+	Move move;
+	/// @brief Score from the searching side's view
+	int score = 0;
+	/// @brief False if alpha-beta only proved the move scores at most this
+	bool exact = false;
+};
+
 /// @brief AI player implementation using minimax algorithm with alpha-beta pruning
 ///
 /// This class provides artificial intelligence for The Fourth Protocol game,
@@ -66,20 +133,40 @@ public:
 	/// @brief Default constructor for AI player
 	AI();
 
-	/// @brief Find the best move for Player 2 (AI) using minimax algorithm with alpha-beta pruning
-	/// @param board Current state of the game board
-	/// @param p2Pieces Reference to Player 2's pieces (AI's pieces)
-	/// @param p1Pieces Reference to Player 1's pieces (human player's pieces)
-	/// @param gridSize Size of the game grid
-	/// @param isPlacementPhase True if in placement phase, false if in movement phase
+	/// @brief Find the best move for the side to move using minimax algorithm with alpha-beta pruning
+	/// @param position Position to search (a private copy, so the caller's pieces are never touched)
 	/// @param depth Maximum search depth for the minimax algorithm
 	/// @param useRandomPlacement If true, selects random placement instead of strategic (for AI vs AI variety)
 	/// @param lastMove The last move made (to avoid immediately undoing it)
 	/// @param strategy The evaluation strategy to use (default: Balanced)
-	/// @return Move object representing the best move found
-	Move findBestMove(const vector<vector<Piece*>>& board, vector<Piece>& p2Pieces, 
-		vector<Piece>& p1Pieces, int gridSize, bool isPlacementPhase, int depth = 3, 
-		bool useRandomPlacement = false, const Move& lastMove = Move(), Strategy strategy = Strategy::Balanced);
+	/// @param history Positions already reached in the game, including this one (for repetition draws)
+	/// @return Move object representing the best move found (piece index into the mover's pieces)
+	Move findBestMove(Position position, int depth = 3, bool useRandomPlacement = false,
+		const Move& lastMove = Move(), Strategy strategy = Strategy::Balanced,
+		const PositionHistory& history = PositionHistory());
+
+	/// @brief Find the best move within a node budget, searching one ply deeper at a time
+	///
+	/// Each depth is searched with the nodes the budget has left, and the move of the
+	/// deepest search that finished is played. Node counts do not depend on the
+	/// machine, so a position, budget and strategy always give the same move and the
+	/// same compute per move. Depth 1 always finishes, so there is a move even when
+	/// the budget is smaller than one ply. The search statistics describe the deepest
+	/// finished search, with the nodes and time of every depth tried.
+	/// @param position Position to search
+	/// @param nodeBudget Search nodes the decision may visit
+	/// @param useRandomPlacement If true, selects random placement instead of strategic (for AI vs AI variety)
+	/// @param lastMove The last move made (to avoid immediately undoing it)
+	/// @param strategy The evaluation strategy to use (default: Balanced)
+	/// @param history Positions already reached in the game, including this one (for repetition draws)
+	/// @return Move object representing the best move found (piece index into the mover's pieces)
+	Move findBestMoveWithinBudget(const Position& position, uint64_t nodeBudget, bool useRandomPlacement = false,
+		const Move& lastMove = Move(), Strategy strategy = Strategy::Balanced,
+		const PositionHistory& history = PositionHistory());
+
+	/// @brief Cap the nodes of every findBestMove search; a search reaching the cap stops as if the stop flag were set
+	/// @param limit Most nodes per search (0 for no limit)
+	void setNodeLimit(uint64_t limit) { m_nodeLimit = limit > 0 ? limit : UINT64_MAX; }
 
 	/// @brief Get the number of moves considered in the last decision
 	/// @return Number of possible moves evaluated
@@ -93,6 +180,73 @@ public:
 	/// @return The Move object that was selected
 	Move getSelectedMove() const { return m_selectedMove; }
 
+	/// @brief Check if the last move was taken from the analysis cache instead of searched
+	/// @return True if the last decision was a cache hit
+	bool wasLastMoveCached() const { return m_lastMoveCached; }
+
+	/// @brief Check if the last move was taken from the opening book
+	/// @return True if the last decision was a book move
+	bool wasLastMoveFromBook() const { return m_lastMoveFromBook; }
+
+	/// @brief Get the number of positions visited by the last search
+	/// @return Search nodes (0 for book, cache or random moves)
+	uint64_t getNodesSearched() const { return m_nodesSearched; }
+
+	/// @brief Get the telemetry of the last decision
+	/// @return Node, cutoff and timing counters and the principal variation
+	const SearchStats& getSearchStats() const { return m_stats; }
+
+	/// @brief Get every move the last search finished, in search order
+	/// @return Root moves with their scores (empty for book, cache and random moves)
+	const vector<RootMove>& getRootMoves() const { return m_rootMoves; }
+
+	/// @brief Check if the last search was cut short by the stop flag (its move must not be used)
+	/// @return True if the search was stopped
+	bool wasStopped() const { return m_stopped; }
+
+	/// @brief Let another thread stop searches early
+	/// @param stop Flag checked at every search node (nullptr to never stop)
+	void setStopFlag(const std::atomic<bool>* stop) { m_stopFlag = stop; }
+
+	/// @brief Get the depth the last returned move was searched to
+	/// @return Search depth, or the stored depth on a cache hit
+	int getLastSearchDepth() const { return m_lastSearchDepth; }
+
+	/// @brief Memory-map an analysis cache that findBestMove probes before searching
+	/// @param path Path of the cache file written by the cache_writer tool
+	/// @return True if the cache was opened, false if it is missing or invalid (cache disabled)
+	bool openAnalysisCache(const string& path);
+
+	/// @brief Memory-map a placement-phase opening book that findBestMove consults first
+	/// @param path Path of the book file written by the book_builder tool
+	/// @return True if the book was opened, false if it is missing or invalid (book disabled)
+	bool openOpeningBook(const string& path);
+
+	/// @brief Open a journal of searched results for the cache_writer tool to merge
+	/// @param path Path of the journal file (created if missing)
+	/// @return True if the journal was opened, false otherwise
+	bool openAnalysisJournal(const string& path);
+
+	/// @brief Append the deepest finished search of the last position to the journal
+	///
+	/// Call once per decision, after the last findBestMove for it, so iterative
+	/// deepening journals one record per move instead of one per depth. Book,
+	/// cache and random moves are not journaled.
+	void journalLastDecision();
+
+	/// @brief Score of a position for a strategy, from Player 2's point of view
+	using ReferenceEvaluation = int (*)(const Position& position, Strategy strategy);
+
+	/// @brief Check evaluateBoard and every supported evaluation kernel against a reference evaluation on random boards
+	/// @param reference Evaluation every path must match exactly
+	/// @param positions Number of random boards per strategy and variant
+	/// @return Number of evaluations that disagreed with the reference (0 if every path matched)
+	int verifyEvaluationKernels(ReferenceEvaluation reference, int positions = 2000);
+
+	/// @brief Get the bitboard kernel used at the search leaves
+	/// @return Kernel selected for this CPU
+	BitboardEvaluator::Kernel getEvaluationKernel() const { return m_bitboardEvaluator.getKernel(); }
+
 private:
 	/// @brief Maximum search depth for the minimax algorithm
 	static const int MAX_DEPTH = 3;
@@ -100,85 +254,208 @@ private:
 	static const int WINNING_SCORE = 10000;
 	/// @brief Score value representing a losing position
 	static const int LOSING_SCORE = -10000;
+	/// @brief Score for a position drawn by repetition
+	static const int DRAW_SCORE = 0;
 
 	/// @brief Number of moves considered in last search
 	int m_movesConsidered = 0;
+	/// @brief Number of minimax nodes visited by the last search
+	uint64_t m_nodesSearched = 0;
+	/// @brief Flag another thread sets to stop the search (nullptr if searches always finish)
+	const std::atomic<bool>* m_stopFlag = nullptr;
+	/// @brief Nodes after which a search stops (UINT64_MAX for no limit)
+	uint64_t m_nodeLimit = UINT64_MAX;
+	/// @brief True if the last search was stopped before it finished
+	bool m_stopped = false;
 	/// @brief Score of the best move found
 	int m_bestScore = 0;
 	/// @brief The selected move from last search
 	Move m_selectedMove;
 	/// @brief Current evaluation strategy
 	Strategy m_strategy = Strategy::Balanced;
+	/// @brief True if the last decision came from the analysis cache
+	bool m_lastMoveCached = false;
+	/// @brief True if the last decision came from the opening book
+	bool m_lastMoveFromBook = false;
+	/// @brief Depth of the last decision
+	int m_lastSearchDepth = 0;
+	/// @brief Telemetry of the last decision
+	SearchStats m_stats;
+	/// @brief Root moves of the last search with their scores
+	vector<RootMove> m_rootMoves;
+	/// @brief Depth the current search started from (ply = m_rootDepth - depth)
+	int m_rootDepth = 0;
+	/// @brief Triangular principal variation table: row p holds the best line found from ply p
+	Move m_pvTable[SearchStats::MAX_PLY][SearchStats::MAX_PLY];
+	/// @brief Length of each row of the principal variation table
+	int m_pvLength[SearchStats::MAX_PLY] = {};
+	/// @brief +1 if the searching side is Player 2, -1 if Player 1 (evaluations are from Player 2's view)
+	int m_perspective = 1;
+
+	/// @brief Read-only cache of previous deep searches
+	AnalysisCache m_analysisCache;
+	/// @brief Precomputed placement moves for the first plies
+	OpeningBook m_openingBook;
+	/// @brief Journal that new search results are appended to (closed = disabled)
+	ofstream m_analysisJournal;
+	/// @brief Deepest finished search of the last position, waiting for journalLastDecision
+	AnalysisRecord m_journalRecord = {};
+	/// @brief True if m_journalRecord has not been written yet
+	bool m_journalPending = false;
+
+	/// @brief Maximum number of cells on the board
+	static const int MAX_CELLS = Position::MAX_CELLS;
+	/// @brief Maximum number of lines: rows, columns and both diagonal directions of the largest board
+	static const int MAX_LINES = 6 * Position::MAX_GRID_SIZE - 2;
+
+	/// @brief A line through a cell and the cell's base-3 place value in that line
+	struct CellLine {
+		/// @brief Line index
+		int line;
+		/// @brief Power of three for the cell's position along the line
+		int power;
+	};
+
+	/// @brief Pattern tables of the current strategy
+	const LinePatterns* m_patterns = nullptr;
+	/// @brief Grid size the line layout was built for
+	int m_lineGridSize = 0;
+	/// @brief Number of lines on the current grid
+	int m_lineCount = 0;
+	/// @brief Orientation of each line
+	LinePatterns::Direction m_lineDirections[MAX_LINES];
+	/// @brief The four lines (horizontal, vertical, both diagonals) through each cell
+	CellLine m_cellLines[MAX_CELLS][4];
+	/// @brief Positional score of a Player 2 piece on each cell, for [movement, placement]
+	int m_cellWeights[2][MAX_CELLS];
+	/// @brief Base-3 code of every line of the search board
+	int m_lineCodes[MAX_LINES];
+	/// @brief Positional part of the evaluation of the search board, for [movement, placement]
+	int m_positionScore[2] = { 0, 0 };
+	/// @brief Bitboard evaluation kernel configured for the current grid and strategy
+	BitboardEvaluator m_bitboardEvaluator;
+	/// @brief True if the grid's lines fit the pattern tables (boards up to 8x8)
+	bool m_useLinePatterns = true;
+	/// @brief True if the search leaves are scored with the bitboard evaluator
+	bool m_useBitboards = false;
+	/// @brief Game history extended with the movement-phase positions on the current search path
+	PositionHistory m_searchHistory;
+
+	/// @brief Search every root move and keep the best
+	///
+	/// Templated on the position storage: boards up to 8x8 are searched on a
+	/// SmallPosition, larger ones on a Position.
+	/// @param position Position to search (modified during search, restored on return)
+	/// @param possibleMoves Root moves in search order
+	/// @param depth Maximum search depth
+	/// @param bestMove Receives the best move (unchanged if the search stopped before any move finished)
+	/// @return Score of the best move, or INT_MIN if no move finished
+	template <class SearchPosition>
+	int searchRoot(SearchPosition& position, const vector<Move>& possibleMoves, int depth, Move& bestMove);
 
 	/// @brief Minimax algorithm implementation with alpha-beta pruning
-	/// @param board Current board state (modified during search)
-	/// @param p2Pieces Reference to Player 2's pieces
-	/// @param p1Pieces Reference to Player 1's pieces
-	/// @param gridSize Size of the game grid
+	/// @param position Current position (modified during search)
 	/// @param depth Current search depth remaining
-	/// @param isMaximizing True if maximizing player's turn (AI), false for minimizing (human)
-	/// @param isPlacementPhase True if in placement phase, false if in movement phase
+	/// @param isMaximizing True if the searching side is to move, false for its opponent
 	/// @param alpha Alpha value for alpha-beta pruning
 	/// @param beta Beta value for alpha-beta pruning
-	/// @return Evaluated score for the current position
-	int minimax(vector<vector<Piece*>>& board, vector<Piece>& p2Pieces, 
-		vector<Piece>& p1Pieces, int gridSize, int depth, bool isMaximizing, 
-		bool isPlacementPhase, int alpha, int beta);
+	/// @param lastCell Cell the previous move landed on (where a winning line would have to pass)
+	/// @return Evaluated score for the current position, from the searching side's view
+	template <class SearchPosition>
+	int minimax(SearchPosition& position, int depth, bool isMaximizing, int alpha, int beta, int lastCell);
+
+	/// @brief Evaluate a position from scratch and return a score
+	/// @param position Position to evaluate
+	/// @return Numerical score representing board favorability (positive = good for Player 2)
+	int evaluateBoard(const Position& position);
 
-	/// @brief Evaluate the current board state and return a score
-	/// @param board Current board state to evaluate
+	/// @brief Evaluate a position on a board too large for the pattern tables by walking every line
+	/// @param position Position to evaluate
+	/// @return Numerical score representing board favorability (positive = good for Player 2)
+	int evaluateLongLines(const Position& position) const;
+
+	/// @brief Evaluate the search board from the incrementally maintained line codes
 	/// @param isPlacementPhase True if in placement phase, false if in movement phase
-	/// @return Numerical score representing board favorability (positive = good for AI)
-	int evaluateBoard(const vector<vector<Piece*>>& board, bool isPlacementPhase);
-
-	/// @brief Count consecutive pieces in a line for scoring purposes
-	/// @param board Current board state
-	/// @param row Starting row position
-	/// @param col Starting column position
-	/// @param dRow Row direction vector (-1, 0, or 1)
-	/// @param dCol Column direction vector (-1, 0, or 1)
-	/// @param isPlayer1 True to count Player 1's pieces, false for Player 2's pieces
-	/// @return Number of consecutive pieces found in the specified direction
-	int countInLine(const vector<vector<Piece*>>& board, int row, int col, int dRow, int dCol, bool isPlayer1);
-
-	/// @brief Generate all possible legal moves for a player
-	/// @param board Current board state
-	/// @param playerPieces Reference to the player's pieces
-	/// @param gridSize Size of the game grid
+	/// @return Same score evaluateBoard would return for the search board
+	int evaluatePatterns(bool isPlacementPhase) const;
+
+	/// @brief Evaluate the search board at a leaf, with the bitboard kernel when it is the faster path
+	/// @param position Search position (its occupancy masks feed the bitboard kernels)
+	/// @return Same score evaluateBoard would return for the search board, from the searching side's view
+	template <class SearchPosition>
+	int evaluateLeaf(const SearchPosition& position) const;
+
+	/// @brief Get the evaluation multipliers of a strategy
+	/// @param strategy Evaluation strategy
 	/// @param isPlacementPhase True if in placement phase, false if in movement phase
-	/// @return Vector of all possible Move objects for the player
-	vector<Move> generateMoves(const vector<vector<Piece*>>& board, vector<Piece>& playerPieces, 
-		int gridSize, bool isPlacementPhase);
-
-	/// @brief Apply a move to the board state (used during search)
-	/// @param board Board state to modify
-	/// @param piece Pointer to the piece to move
-	/// @param fromRow Source row position
-	/// @param fromCol Source column position
-	/// @param toRow Target row position
-	/// @param toCol Target column position
-	void applyMove(vector<vector<Piece*>>& board, Piece* piece, int fromRow, int fromCol, int toRow, int toCol);
-
-	/// @brief Undo a move on the board state (used during search backtracking)
-	/// @param board Board state to modify
-	/// @param piece Pointer to the piece to move back
-	/// @param fromRow Original row position
-	/// @param fromCol Original column position
-	/// @param toRow Current row position
-	/// @param toCol Current column position
-	void undoMove(vector<vector<Piece*>>& board, Piece* piece, int fromRow, int fromCol, int toRow, int toCol);
-
-	/// @brief Check if a player has achieved a win condition (4 in a row)
-	/// @param board Current board state to check
-	/// @param isPlayer1 True to check Player 1's win condition, false for Player 2
-	/// @return True if the player has won, false otherwise
-	bool hasWon(const vector<vector<Piece*>>& board, bool isPlayer1);
-
-	/// @brief Find all empty cells on the board
-	/// @param board Current board state
+	/// @return Multipliers used by the evaluation
+	static EvalWeights weightsFor(Strategy strategy, bool isPlacementPhase);
+
+	/// @brief Get the precomputed line pattern scores of a strategy (built on first use)
+	/// @param strategy Evaluation strategy
+	/// @return Pattern tables shared by all AI instances
+	static const LinePatterns& patternsFor(Strategy strategy);
+
+	/// @brief Number the lines of a grid (up to 8x8) and precompute per-cell positional weights for the current strategy
 	/// @param gridSize Size of the game grid
-	/// @return Vector of coordinate pairs representing empty positions
-	vector<pair<int, int>> getEmptyCells(const vector<vector<Piece*>>& board, int gridSize);
+	void setupLines(int gridSize);
+
+	/// @brief Recompute every line code and positional score from a position
+	/// @param position Position the search starts from
+	void resetPatterns(const Position& position);
+
+	/// @brief Add or remove a piece from the line codes and positional score
+	/// @param cell Row-major cell index
+	/// @param isPlayer1 True if the piece belongs to Player 1
+	/// @param sign +1 to add the piece, -1 to remove it
+	void updatePatterns(int cell, bool isPlayer1, int sign);
+
+	/// @brief Generate all possible legal moves for the side to move
+	/// @param position Current position
+	/// @return Vector of all possible Move objects for the side to move
+	template <class SearchPosition>
+	vector<Move> generateMoves(const SearchPosition& position);
+
+	/// @brief Apply a move for the side to move and pass the turn (used during search)
+	///
+	/// The last placement ends the placement phase with Player 1 to move, as in
+	/// Match::play, so the search carries on with movement-phase moves.
+	/// @param position Position to modify
+	/// @param move Move to apply
+	template <class SearchPosition>
+	void applyMove(SearchPosition& position, const Move& move);
+
+	/// @brief Undo a move applied by applyMove (used during search backtracking)
+	/// @param position Position to modify
+	/// @param move Move to take back
+	template <class SearchPosition>
+	void undoMove(SearchPosition& position, const Move& move);
 
 	int scoreCloserToCenter(int row, int col, int gridSize);
+
+	/// @brief Make a move the head of the best line from a ply, followed by the best line of the next ply
+	/// @param ply Distance of the node from the root
+	/// @param move Move that became the best at this node
+	void updatePrincipalVariation(int ply, const Move& move);
+
+	/// @brief Count an alpha-beta cutoff
+	/// @param ply Distance of the node from the root
+	/// @param firstMove True if the first move searched at the node caused it
+	void recordCutoff(int ply, bool firstMove);
+
+	/// @brief Derive the elapsed time, rates and principal variation of a decision
+	/// @param start Time the decision started
+	void finishSearchStats(std::chrono::steady_clock::time_point start);
+
+	/// @brief Look up the current placement position in the opening book
+	/// @param position Current position
+	/// @param possibleMoves Legal moves for the side to move; the book move must be one of them
+	/// @param bookMove Receives the book move if one was found
+	/// @return True if the book has a legal move for this position and strategy
+	bool probeOpeningBook(const Position& position, const vector<Move>& possibleMoves, Move& bookMove);
+
+	/// @brief Hash a position for the analysis cache, including side to move, phase and strategy
+	/// @param position Current position
+	/// @return 64-bit position hash
+	uint64_t hashPosition(const Position& position);
 };
@@ -0,0 +1,73 @@
+#include "AllocationTracker.h"
+
+#ifdef TRACK_ALLOCATIONS
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	/// @brief Space in front of every block for its size, keeping the block aligned as malloc does
+	const size_t HEADER_SIZE = alignof(std::max_align_t);
+
+	/// @brief Running counts of one thread
+	struct ThreadCounts {
+		/// @brief True between begin() and end()
+		bool active;
+		/// @brief Calls to operator new
+		uint64_t allocations;
+		/// @brief Bytes requested from operator new
+		uint64_t bytes;
+		/// @brief Bytes allocated minus bytes freed since begin() (negative if older blocks were freed)
+		int64_t liveBytes;
+		/// @brief Highest liveBytes since begin()
+		int64_t peakBytes;
+	};
+
+	/// @brief Counts of the calling thread (plain data, so usable from operator new at any time)
+	thread_local ThreadCounts s_counts;
+}
+
+void AllocationTracker::begin()
+{
+	s_counts = ThreadCounts();
+	s_counts.active = true;
+}
+
+AllocationTracker::Counts AllocationTracker::end()
+{
+	s_counts.active = false;
+
+	Counts counts;
+	counts.allocations = s_counts.allocations;
+	counts.bytes = s_counts.bytes;
+	counts.peakBytes = static_cast<uint64_t>(s_counts.peakBytes > 0 ? s_counts.peakBytes : 0);
+	return counts;
+}
+
+// The array, nothrow and sized forms all forward to these two by default
+void* operator new(size_t size)
+{
+	unsigned char* block = static_cast<unsigned char*>(std::malloc(size + HEADER_SIZE));
+	if (!block) throw std::bad_alloc();
+
+	*reinterpret_cast<size_t*>(block) = size;
+	if (s_counts.active) {
+		++s_counts.allocations;
+		s_counts.bytes += size;
+		s_counts.liveBytes += static_cast<int64_t>(size);
+		if (s_counts.liveBytes > s_counts.peakBytes) s_counts.peakBytes = s_counts.liveBytes;
+	}
+	return block + HEADER_SIZE;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	if (!pointer) return;
+
+	unsigned char* block = static_cast<unsigned char*>(pointer) - HEADER_SIZE;
+	if (s_counts.active) {
+		s_counts.liveBytes -= static_cast<int64_t>(*reinterpret_cast<size_t*>(block));
+	}
+	std::free(block);
+}
+#endif
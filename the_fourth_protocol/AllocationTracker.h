@@ -0,0 +1,57 @@
+/**
+ * @file AllocationTracker.h
+ * @brief Opt-in heap allocation counting for AI searches
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the AllocationTracker namespace, which counts the heap
+ * allocations a thread makes between begin() and end() so the search
+ * statistics can report allocations per node and peak heap use. Counting
+ * replaces the global operator new and delete, so it is compiled only when
+ * TRACK_ALLOCATIONS is defined; otherwise begin() and end() are empty and
+ * every count reads zero.
+ */
+
+#pragma once
+#include <cstdint>
+
+// TRACK_ALLOCATIONS comes from a project's preprocessor definitions, so only the
+//  programs that ask for it pay for the counting operator new. The tournament
+//  runner defines it in every configuration and can fail a run on too many
+//  allocations per node; add it to another project to count its searches too.
+
+/// @brief Per-thread counts of heap allocations
+namespace AllocationTracker {
+	/// @brief Heap use of the calling thread between begin() and end()
+	struct Counts {
+		/// @brief Calls to operator new
+		uint64_t allocations = 0;
+		/// @brief Bytes requested from operator new
+		uint64_t bytes = 0;
+		/// @brief Most bytes allocated and not yet freed at any one time
+		uint64_t peakBytes = 0;
+	};
+
+#ifdef TRACK_ALLOCATIONS
+	/// @brief True if allocations are being counted in this build
+	constexpr bool ENABLED = true;
+
+	/// @brief Start counting the calling thread's allocations from zero
+	void begin();
+
+	/// @brief Stop counting the calling thread's allocations
+	/// @return Counts since begin()
+	Counts end();
+#else
+	/// @brief True if allocations are being counted in this build
+	constexpr bool ENABLED = false;
+
+	/// @brief Start counting the calling thread's allocations from zero (nothing to do in this build)
+	inline void begin() {}
+
+	/// @brief Stop counting the calling thread's allocations
+	/// @return Zero counts in this build
+	inline Counts end() { return Counts(); }
+#endif
+}
@@ -0,0 +1,93 @@
+#include "AnalysisCache.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+	const char CACHE_MAGIC[4] = { 'T', '4', 'A', 'C' };
+}
+
+bool AnalysisCache::open(const std::string& path)
+{
+	close();
+	if (!m_file.open(path)) return false;
+
+	if (m_file.size() < sizeof(AnalysisCacheHeader)) {
+		close();
+		return false;
+	}
+
+	AnalysisCacheHeader header;
+	std::memcpy(&header, m_file.data(), sizeof(header));
+	uint64_t available = (m_file.size() - sizeof(header)) / sizeof(AnalysisRecord);
+	if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+		header.version != VERSION || header.count > available) {
+		close();
+		return false;
+	}
+
+	m_records = reinterpret_cast<const AnalysisRecord*>(m_file.data() + sizeof(header));
+	m_count = header.count;
+	return true;
+}
+
+void AnalysisCache::close()
+{
+	m_file.close();
+	m_records = nullptr;
+	m_count = 0;
+}
+
+const AnalysisRecord* AnalysisCache::find(uint64_t hash) const
+{
+	if (!m_records) return nullptr;
+
+	const AnalysisRecord* last = end();
+	const AnalysisRecord* it = std::lower_bound(m_records, last, hash,
+		[](const AnalysisRecord& record, uint64_t key) { return record.hash < key; });
+
+	if (it != last && it->hash == hash) return it;
+	return nullptr;
+}
+
+bool AnalysisCache::write(const std::string& path, std::vector<AnalysisRecord> records)
+{
+	// Stable sort keeps records in input order within a hash, so later results win ties
+	std::stable_sort(records.begin(), records.end(),
+		[](const AnalysisRecord& a, const AnalysisRecord& b) { return a.hash < b.hash; });
+
+	std::vector<AnalysisRecord> merged;
+	merged.reserve(records.size());
+	for (const auto& record : records) {
+		if (!merged.empty() && merged.back().hash == record.hash) {
+			if (record.depth >= merged.back().depth) merged.back() = record;
+		} else {
+			merged.push_back(record);
+		}
+	}
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out) return false;
+
+	AnalysisCacheHeader header;
+	std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	header.version = VERSION;
+	header.count = merged.size();
+
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(merged.data()),
+		static_cast<std::streamsize>(merged.size() * sizeof(AnalysisRecord)));
+	return static_cast<bool>(out);
+}
+
+bool AnalysisCache::readJournal(const std::string& path, std::vector<AnalysisRecord>& records)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (!in) return false;
+
+	AnalysisRecord record;
+	while (in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+		records.push_back(record);
+	}
+	return true;
+}
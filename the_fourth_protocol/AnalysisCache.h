@@ -0,0 +1,113 @@
+/**
+ * @file AnalysisCache.h
+ * @brief On-disk cache of deep search results for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the AnalysisCache class, a read-only table of previous
+ * search results (position hash -> score, depth, best move) that is
+ * memory-mapped at startup and probed by the AI before searching.
+ *
+ * File layout: an AnalysisCacheHeader followed by `count` AnalysisRecords
+ * sorted by hash. Journals written by the AI are plain AnalysisRecords with
+ * no header, in the order they were produced; the cache_writer tool merges
+ * journals into a cache file.
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+/// @brief One stored search result
+struct AnalysisRecord {
+	/// @brief Position hash (see AI::hashPosition)
+	uint64_t hash;
+	/// @brief Score of the best move, from the point of view of the side to move
+	int32_t score;
+	/// @brief Depth the position was searched to
+	uint8_t depth;
+	/// @brief Index of the piece to move in the side to move's piece collection
+	int8_t pieceIndex;
+	/// @brief Source row of the best move (-1 for placements)
+	int8_t fromRow;
+	/// @brief Source column of the best move (-1 for placements)
+	int8_t fromCol;
+	/// @brief Target row of the best move
+	int8_t toRow;
+	/// @brief Target column of the best move
+	int8_t toCol;
+	/// @brief Padding, always zero
+	uint8_t reserved[6];
+};
+static_assert(sizeof(AnalysisRecord) == 24, "AnalysisRecord is part of the file format");
+
+/// @brief Header at the start of an analysis cache file
+struct AnalysisCacheHeader {
+	/// @brief File identifier, always "T4AC"
+	char magic[4];
+	/// @brief File format version
+	uint32_t version;
+	/// @brief Number of records following the header
+	uint64_t count;
+};
+static_assert(sizeof(AnalysisCacheHeader) == 16, "AnalysisCacheHeader is part of the file format");
+
+/// @brief Memory-mapped, read-only table of search results sorted by position hash
+class AnalysisCache
+{
+public:
+	/// @brief Current file format version
+	static const uint32_t VERSION = 1;
+
+	/// @brief Map a cache file and validate its header
+	/// @param path Path of the cache file
+	/// @return True if the file was mapped and is a valid cache, false otherwise
+	bool open(const std::string& path);
+
+	/// @brief Unmap the cache file
+	void close();
+
+	/// @brief Check if a cache file is mapped
+	/// @return True if probes can succeed
+	bool isOpen() const { return m_records != nullptr; }
+
+	/// @brief Look up a position by hash (binary search over the mapped records)
+	/// @param hash Position hash to look up
+	/// @return Pointer to the stored record, or nullptr if the position is not cached
+	const AnalysisRecord* find(uint64_t hash) const;
+
+	/// @brief Get the number of records in the cache
+	/// @return Number of records
+	uint64_t size() const { return m_count; }
+
+	/// @brief Get the first record (records are sorted by hash)
+	/// @return Pointer to the first record, or nullptr if closed
+	const AnalysisRecord* begin() const { return m_records; }
+
+	/// @brief Get one past the last record
+	/// @return Pointer one past the last record, or nullptr if closed
+	const AnalysisRecord* end() const { return m_records ? m_records + m_count : nullptr; }
+
+	/// @brief Sort records by hash, drop duplicates (keeping the deepest) and write a cache file
+	/// @param path Path of the cache file to write
+	/// @param records Records to write, in any order; later records win ties on depth
+	/// @return True if the whole file was written, false otherwise
+	static bool write(const std::string& path, std::vector<AnalysisRecord> records);
+
+	/// @brief Read every record from a journal file
+	/// @param path Path of the journal file
+	/// @param records Vector the records are appended to
+	/// @return True if the journal was read, false if it could not be opened
+	static bool readJournal(const std::string& path, std::vector<AnalysisRecord>& records);
+
+private:
+	/// @brief The mapped cache file
+	MappedFile m_file;
+	/// @brief First record inside the mapping
+	const AnalysisRecord* m_records = nullptr;
+	/// @brief Number of records inside the mapping
+	uint64_t m_count = 0;
+};
@@ -0,0 +1,358 @@
+#include "BitboardEvaluator.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define T4P_X86 1
+#define T4P_TARGET(isa)
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define T4P_X86 1
+#define T4P_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace {
+	/// @brief Portable population count (SWAR), safe on CPUs without POPCNT
+	inline int popCount(uint64_t x)
+	{
+		x = x - ((x >> 1) & 0x5555555555555555ULL);
+		x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+		x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+	}
+
+	/// @brief Population count of a multi-word mask
+	inline int popCount(const BoardMask& mask)
+	{
+		int count = 0;
+		for (uint64_t word : mask.words) count += popCount(word);
+		return count;
+	}
+
+	/// @brief Score of one run of n pieces: each of its n pieces scores the old per-piece n*n term
+	int runScore(int n, int multiplier, const EvalWeights& weights, bool isPlayer1)
+	{
+		if (n <= 0) return 0;
+		if (isPlayer1) {
+			int perPiece = (n >= 3) ? n * n * multiplier * 2 * weights.defense : n * n * multiplier * weights.defense;
+			return -n * perPiece;
+		}
+		int perPiece = (n >= 3) ? n * n * multiplier * 15 / 10 * weights.offense : n * n * multiplier * weights.offense;
+		return n * perPiece;
+	}
+
+#ifdef T4P_X86
+	/// @brief Which kernels this CPU supports, detected once
+	struct CpuFeatures {
+		bool sse41 = false;
+		bool avx2 = false;
+
+		CpuFeatures()
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			int maxLeaf = info[0];
+			__cpuid(info, 1);
+			bool ssse3 = (info[2] & (1 << 9)) != 0;
+			sse41 = ssse3 && (info[2] & (1 << 19)) != 0;
+			bool osAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 &&
+				(_xgetbv(0) & 0x6) == 0x6;
+			if (maxLeaf >= 7 && osAvx) {
+				__cpuidex(info, 7, 0);
+				avx2 = sse41 && (info[1] & (1 << 5)) != 0;
+			}
+#else
+			__builtin_cpu_init();
+			sse41 = __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.1");
+			avx2 = sse41 && __builtin_cpu_supports("avx2");
+#endif
+		}
+	};
+
+	const CpuFeatures& cpuFeatures()
+	{
+		static const CpuFeatures features;
+		return features;
+	}
+#endif
+}
+
+BitboardEvaluator::BitboardEvaluator()
+{
+	if (isSupported(Kernel::AVX2)) m_kernel = Kernel::AVX2;
+	else if (isSupported(Kernel::SSE41)) m_kernel = Kernel::SSE41;
+}
+
+bool BitboardEvaluator::isSupported(Kernel kernel)
+{
+	switch (kernel) {
+		case Kernel::Scalar:
+			return true;
+#ifdef T4P_X86
+		case Kernel::SSE41:
+			return cpuFeatures().sse41;
+		case Kernel::AVX2:
+			return cpuFeatures().avx2;
+#endif
+		default:
+			return false;
+	}
+}
+
+const char* BitboardEvaluator::kernelName(Kernel kernel)
+{
+	switch (kernel) {
+		case Kernel::SSE41: return "SSE4.1";
+		case Kernel::AVX2: return "AVX2";
+		case Kernel::Scalar:
+		default: return "Scalar";
+	}
+}
+
+void BitboardEvaluator::setKernel(Kernel kernel)
+{
+	if (isSupported(kernel)) m_kernel = kernel;
+}
+
+void BitboardEvaluator::configure(int gridSize, const EvalWeights& weights, const int* const cellWeights[2])
+{
+	m_gridSize = gridSize;
+	const int last = gridSize - 1;
+
+	// Horizontal, vertical, diagonal (\) and diagonal (/) steps between neighbouring bits
+	m_shifts[0] = 1;
+	m_shifts[1] = gridSize;
+	m_shifts[2] = gridSize + 1;
+	m_shifts[3] = gridSize - 1;
+	for (int d = 0; d < 4; ++d) {
+		m_valid[d] = 0;
+		m_wideValid[d] = {};
+	}
+	for (int row = 0; row < gridSize; ++row) {
+		for (int col = 0; col < gridSize; ++col) {
+			const bool valid[4] = { col < last, row < last, row < last && col < last, row < last && col > 0 };
+			const int cell = row * gridSize + col;
+			for (int d = 0; d < 4; ++d) {
+				if (!valid[d]) continue;
+				m_wideValid[d].set(cell);
+				if (gridSize <= MAX_GRID_SIZE) m_valid[d] |= 1ULL << cell;
+			}
+		}
+	}
+
+	// popcount(X(k)) counts max(0, n-k+1) for every run of length n, so weighting it with the
+	// second difference of the run score makes the sum over k equal the sum of run scores
+	const int multipliers[4] = { weights.horizontal, weights.vertical, weights.diagonal, weights.diagonal };
+	for (int player = 0; player < 2; ++player) {
+		for (int d = 0; d < 4; ++d) {
+			m_runWeights[player][0][d] = 0;
+			for (int k = 1; k <= MAX_WIDE_GRID_SIZE; ++k) {
+				m_runWeights[player][k][d] =
+					runScore(k, multipliers[d], weights, player == 0)
+					- 2 * runScore(k - 1, multipliers[d], weights, player == 0)
+					+ runScore(k - 2, multipliers[d], weights, player == 0);
+			}
+			for (int k = 0; k <= MAX_WIDE_GRID_SIZE; ++k) {
+				m_pairedRunWeights[d][k][player] = m_runWeights[player][k][d];
+			}
+		}
+	}
+
+	for (int phase = 0; phase < 2; ++phase) {
+		for (int plane = 0; plane < PLANE_COUNT; ++plane) {
+			m_planes[phase][plane] = 0;
+			m_widePlanes[phase][plane] = {};
+			for (int cell = 0; cell < gridSize * gridSize; ++cell) {
+				if (!(cellWeights[phase][cell] & (1 << plane))) continue;
+				m_widePlanes[phase][plane].set(cell);
+				if (gridSize <= MAX_GRID_SIZE) m_planes[phase][plane] |= 1ULL << cell;
+			}
+		}
+	}
+	for (int plane = 0; plane < PLANE_COUNT; ++plane) {
+		m_planeWeights[0][plane] = -(1LL << plane);
+		m_planeWeights[1][plane] = 1LL << plane;
+		m_pairedPlaneWeights[plane][0] = m_planeWeights[0][plane];
+		m_pairedPlaneWeights[plane][1] = m_planeWeights[1][plane];
+	}
+}
+
+int BitboardEvaluator::evaluate(uint64_t player1, uint64_t player2, bool isPlacementPhase) const
+{
+	return evaluateWith(m_kernel, player1, player2, isPlacementPhase);
+}
+
+void BitboardEvaluator::evaluateBatch(const uint64_t* player1, const uint64_t* player2, int count, bool isPlacementPhase, int* scores) const
+{
+	for (int i = 0; i < count; ++i) {
+		scores[i] = evaluateWith(m_kernel, player1[i], player2[i], isPlacementPhase);
+	}
+}
+
+int BitboardEvaluator::evaluateWith(Kernel kernel, uint64_t player1, uint64_t player2, bool isPlacementPhase) const
+{
+	switch (kernel) {
+		case Kernel::AVX2: return evaluateAVX2(player1, player2, isPlacementPhase);
+		case Kernel::SSE41: return evaluateSSE41(player1, player2, isPlacementPhase);
+		case Kernel::Scalar:
+		default: return evaluateScalar(player1, player2, isPlacementPhase);
+	}
+}
+
+int BitboardEvaluator::evaluateScalar(uint64_t player1, uint64_t player2, bool isPlacementPhase) const
+{
+	const uint64_t masks[2] = { player1, player2 };
+	const uint64_t* planes = m_planes[isPlacementPhase ? 1 : 0];
+	int score = 0;
+
+	for (int player = 0; player < 2; ++player) {
+		const uint64_t mask = masks[player];
+		for (int plane = 0; plane < PLANE_COUNT; ++plane) {
+			score += popCount(mask & planes[plane]) * static_cast<int>(m_planeWeights[player][plane]);
+		}
+
+		const int single = popCount(mask);
+		for (int d = 0; d < 4; ++d) {
+			uint64_t runs = mask;
+			score += single * static_cast<int>(m_runWeights[player][1][d]);
+			for (int k = 2; k <= m_gridSize && runs; ++k) {
+				runs &= (runs >> m_shifts[d]) & m_valid[d];
+				score += popCount(runs) * static_cast<int>(m_runWeights[player][k][d]);
+			}
+		}
+	}
+	return score;
+}
+
+int BitboardEvaluator::evaluateWide(const BoardMask& player1, const BoardMask& player2, bool isPlacementPhase) const
+{
+	const BoardMask* masks[2] = { &player1, &player2 };
+	const BoardMask* planes = m_widePlanes[isPlacementPhase ? 1 : 0];
+	int score = 0;
+
+	for (int player = 0; player < 2; ++player) {
+		const BoardMask& mask = *masks[player];
+		for (int plane = 0; plane < PLANE_COUNT; ++plane) {
+			score += popCount(mask & planes[plane]) * static_cast<int>(m_planeWeights[player][plane]);
+		}
+
+		const int single = popCount(mask);
+		for (int d = 0; d < 4; ++d) {
+			BoardMask runs = mask;
+			score += single * static_cast<int>(m_runWeights[player][1][d]);
+			for (int k = 2; k <= m_gridSize; ++k) {
+				runs &= (runs >> static_cast<int>(m_shifts[d])) & m_wideValid[d];
+				if (!runs.any()) break;
+				score += popCount(runs) * static_cast<int>(m_runWeights[player][k][d]);
+			}
+		}
+	}
+	return score;
+}
+
+#ifdef T4P_X86
+namespace {
+	/// @brief Per-64-bit-lane popcount (SSSE3 nibble lookup, summed with SAD)
+	T4P_TARGET("ssse3,sse4.1")
+	inline __m128i popCount128(__m128i x)
+	{
+		const __m128i lookup = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m128i low = _mm_set1_epi8(0x0F);
+		__m128i counts = _mm_add_epi8(
+			_mm_shuffle_epi8(lookup, _mm_and_si128(x, low)),
+			_mm_shuffle_epi8(lookup, _mm_and_si128(_mm_srli_epi16(x, 4), low)));
+		return _mm_sad_epu8(counts, _mm_setzero_si128());
+	}
+
+	/// @brief Per-64-bit-lane popcount (AVX2 nibble lookup, summed with SAD)
+	T4P_TARGET("avx2")
+	inline __m256i popCount256(__m256i x)
+	{
+		const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i low = _mm256_set1_epi8(0x0F);
+		__m256i counts = _mm256_add_epi8(
+			_mm256_shuffle_epi8(lookup, _mm256_and_si256(x, low)),
+			_mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(x, 4), low)));
+		return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+	}
+}
+
+T4P_TARGET("ssse3,sse4.1")
+int BitboardEvaluator::evaluateSSE41(uint64_t player1, uint64_t player2, bool isPlacementPhase) const
+{
+	// Lane 0 holds Player 1, lane 1 Player 2; popcounts are below 2^32, so a 32-bit
+	// multiply of the low halves gives count * weight in the low half of each lane
+	const __m128i masks = _mm_set_epi64x(static_cast<long long>(player2), static_cast<long long>(player1));
+	const uint64_t* planes = m_planes[isPlacementPhase ? 1 : 0];
+	__m128i total = _mm_setzero_si128();
+
+	for (int plane = 0; plane < PLANE_COUNT; ++plane) {
+		__m128i counts = popCount128(_mm_and_si128(masks, _mm_set1_epi64x(static_cast<long long>(planes[plane]))));
+		__m128i weights = _mm_load_si128(reinterpret_cast<const __m128i*>(m_pairedPlaneWeights[plane]));
+		total = _mm_add_epi32(total, _mm_mullo_epi32(counts, weights));
+	}
+
+	const __m128i singles = popCount128(masks);
+	for (int d = 0; d < 4; ++d) {
+		const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(m_shifts[d]));
+		const __m128i valid = _mm_set1_epi64x(static_cast<long long>(m_valid[d]));
+		const __m128i* runWeights = reinterpret_cast<const __m128i*>(m_pairedRunWeights[d]);
+		__m128i runs = masks;
+		total = _mm_add_epi32(total, _mm_mullo_epi32(singles, _mm_load_si128(runWeights + 1)));
+
+		for (int k = 2; k <= m_gridSize; ++k) {
+			runs = _mm_and_si128(_mm_and_si128(runs, _mm_srl_epi64(runs, shift)), valid);
+			if (_mm_testz_si128(runs, runs)) break;
+			total = _mm_add_epi32(total, _mm_mullo_epi32(popCount128(runs), _mm_load_si128(runWeights + k)));
+		}
+	}
+
+	return _mm_cvtsi128_si32(total) + _mm_extract_epi32(total, 2);
+}
+
+T4P_TARGET("avx2")
+int BitboardEvaluator::evaluateAVX2(uint64_t player1, uint64_t player2, bool isPlacementPhase) const
+{
+	// The four lanes walk the four directions of one player at a time
+	const __m256i shifts = _mm256_load_si256(reinterpret_cast<const __m256i*>(m_shifts));
+	const __m256i valid = _mm256_load_si256(reinterpret_cast<const __m256i*>(m_valid));
+	const __m256i planesLow = _mm256_load_si256(reinterpret_cast<const __m256i*>(&m_planes[isPlacementPhase ? 1 : 0][0]));
+	const __m256i planesHigh = _mm256_load_si256(reinterpret_cast<const __m256i*>(&m_planes[isPlacementPhase ? 1 : 0][4]));
+	const uint64_t masks[2] = { player1, player2 };
+	__m256i total = _mm256_setzero_si256();
+
+	for (int player = 0; player < 2; ++player) {
+		const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(masks[player]));
+		const __m256i* runWeights = reinterpret_cast<const __m256i*>(m_runWeights[player]);
+		const __m256i* planeWeights = reinterpret_cast<const __m256i*>(m_planeWeights[player]);
+
+		total = _mm256_add_epi32(total, _mm256_mullo_epi32(popCount256(_mm256_and_si256(mask, planesLow)),
+			_mm256_load_si256(planeWeights)));
+		total = _mm256_add_epi32(total, _mm256_mullo_epi32(popCount256(_mm256_and_si256(mask, planesHigh)),
+			_mm256_load_si256(planeWeights + 1)));
+
+		__m256i runs = mask;
+		total = _mm256_add_epi32(total, _mm256_mullo_epi32(popCount256(runs), _mm256_load_si256(runWeights + 1)));
+		for (int k = 2; k <= m_gridSize; ++k) {
+			runs = _mm256_and_si256(_mm256_and_si256(runs, _mm256_srlv_epi64(runs, shifts)), valid);
+			if (_mm256_testz_si256(runs, runs)) break;
+			total = _mm256_add_epi32(total, _mm256_mullo_epi32(popCount256(runs), _mm256_load_si256(runWeights + k)));
+		}
+	}
+
+	__m128i sum = _mm_add_epi32(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+	return _mm_cvtsi128_si32(sum) + _mm_extract_epi32(sum, 2);
+}
+#else
+int BitboardEvaluator::evaluateSSE41(uint64_t player1, uint64_t player2, bool isPlacementPhase) const
+{
+	return evaluateScalar(player1, player2, isPlacementPhase);
+}
+
+int BitboardEvaluator::evaluateAVX2(uint64_t player1, uint64_t player2, bool isPlacementPhase) const
+{
+	return evaluateScalar(player1, player2, isPlacementPhase);
+}
+#endif
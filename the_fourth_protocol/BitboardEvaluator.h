@@ -0,0 +1,132 @@
+/**
+ * @file BitboardEvaluator.h
+ * @brief SIMD bitboard evaluation kernel for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the BitboardEvaluator class, which scores a position
+ * from one 64-bit occupancy mask per player (bit row * gridSize + col).
+ *
+ * Runs are found with shifted ANDs: X(1) is the mask itself and
+ * X(k+1) = X(k) & (X(k) >> step) keeps the cells that start k+1 pieces in a
+ * row along a direction. The evaluation is linear in the popcounts of these
+ * masks, so it reduces to popcount-weighted sums. AVX2 processes all four
+ * directions at once, SSE4.1 both players at once, and a scalar fallback
+ * is used on any other CPU. The kernel is chosen once at runtime.
+ *
+ * Boards above 8x8 use the same run counting on a multi-word BoardMask
+ * (evaluateWide), since their lines are too long for the pattern tables.
+ */
+
+#pragma once
+#include <cstdint>
+#include "LinePatterns.h"
+#include "WideMask.h"
+
+/// @brief Bitboard evaluation kernel matching AI::evaluateBoard, with runtime SIMD dispatch
+class BitboardEvaluator
+{
+public:
+	/// @brief Instruction set used by an evaluation kernel
+	enum class Kernel {
+		Scalar,		///< Portable C++ fallback
+		SSE41,		///< SSE4.1, both players in parallel
+		AVX2		///< AVX2, all four directions in parallel
+	};
+
+	/// @brief Largest grid that fits in one 64-bit mask
+	static const int MAX_GRID_SIZE = 8;
+	/// @brief Largest grid that fits in a BoardMask (scored with evaluateWide)
+	static const int MAX_WIDE_GRID_SIZE = 16;
+	/// @brief Number of bit planes used for positional weights (weights below 256)
+	static const int PLANE_COUNT = 8;
+
+	/// @brief Default constructor selecting the fastest kernel this CPU supports
+	BitboardEvaluator();
+
+	/// @brief Precompute masks and weights for a grid and strategy
+	/// @param gridSize Size of the game grid (at most MAX_WIDE_GRID_SIZE; the 64-bit kernels need MAX_GRID_SIZE)
+	/// @param weights Line multipliers of the strategy
+	/// @param cellWeights Positional score of a Player 2 piece on each cell, for [movement, placement]
+	void configure(int gridSize, const EvalWeights& weights, const int* const cellWeights[2]);
+
+	/// @brief Score a position with the selected kernel
+	/// @param player1 Occupancy mask of Player 1's pieces
+	/// @param player2 Occupancy mask of Player 2's pieces
+	/// @param isPlacementPhase True if in placement phase, false if in movement phase
+	/// @return Score from Player 2's point of view, identical to AI::evaluateBoard
+	int evaluate(uint64_t player1, uint64_t player2, bool isPlacementPhase) const;
+
+	/// @brief Score many positions with the selected kernel
+	/// @param player1 Occupancy masks of Player 1's pieces
+	/// @param player2 Occupancy masks of Player 2's pieces
+	/// @param count Number of positions
+	/// @param isPlacementPhase True if in placement phase, false if in movement phase
+	/// @param scores Receives one score per position
+	void evaluateBatch(const uint64_t* player1, const uint64_t* player2, int count, bool isPlacementPhase, int* scores) const;
+
+	/// @brief Score a position with a specific kernel (it must be supported)
+	/// @param kernel Kernel to use
+	/// @param player1 Occupancy mask of Player 1's pieces
+	/// @param player2 Occupancy mask of Player 2's pieces
+	/// @param isPlacementPhase True if in placement phase, false if in movement phase
+	/// @return Score from Player 2's point of view
+	int evaluateWith(Kernel kernel, uint64_t player1, uint64_t player2, bool isPlacementPhase) const;
+
+	/// @brief Score a position on any configured grid from multi-word masks
+	/// @param player1 Occupancy mask of Player 1's pieces
+	/// @param player2 Occupancy mask of Player 2's pieces
+	/// @param isPlacementPhase True if in placement phase, false if in movement phase
+	/// @return Score from Player 2's point of view, identical to AI::evaluateBoard
+	int evaluateWide(const BoardMask& player1, const BoardMask& player2, bool isPlacementPhase) const;
+
+	/// @brief Get the kernel used by evaluate
+	/// @return Selected kernel
+	Kernel getKernel() const { return m_kernel; }
+
+	/// @brief Select the kernel used by evaluate (ignored if this CPU does not support it)
+	/// @param kernel Kernel to use
+	void setKernel(Kernel kernel);
+
+	/// @brief Check if this CPU can run a kernel
+	/// @param kernel Kernel to check
+	/// @return True if the kernel can be used
+	static bool isSupported(Kernel kernel);
+
+	/// @brief Get a printable name for a kernel
+	/// @param kernel Kernel to name
+	/// @return Short name such as "AVX2"
+	static const char* kernelName(Kernel kernel);
+
+private:
+	/// @brief Scalar kernel
+	int evaluateScalar(uint64_t player1, uint64_t player2, bool isPlacementPhase) const;
+	/// @brief SSE4.1 kernel
+	int evaluateSSE41(uint64_t player1, uint64_t player2, bool isPlacementPhase) const;
+	/// @brief AVX2 kernel
+	int evaluateAVX2(uint64_t player1, uint64_t player2, bool isPlacementPhase) const;
+
+	/// @brief Kernel used by evaluate
+	Kernel m_kernel = Kernel::Scalar;
+	/// @brief Size of the configured grid
+	int m_gridSize = 0;
+	/// @brief Shift to the next cell along each direction (horizontal, vertical, both diagonals)
+	alignas(32) int64_t m_shifts[4] = {};
+	/// @brief Cells whose next cell along each direction is still on the board
+	alignas(32) uint64_t m_valid[4] = {};
+	/// @brief Weight of popcount(X(k)) for [player][k][direction], player 0 = Player 1
+	alignas(32) int64_t m_runWeights[2][MAX_WIDE_GRID_SIZE + 1][4] = {};
+	/// @brief Cells whose positional weight has each bit set, for [movement, placement]
+	alignas(32) uint64_t m_planes[2][PLANE_COUNT] = {};
+	/// @brief Weight of each plane for [player][plane] (+2^b for Player 2, -2^b for Player 1)
+	alignas(32) int64_t m_planeWeights[2][PLANE_COUNT] = {};
+	/// @brief m_runWeights laid out as [direction][k][player] for the SSE4.1 kernel
+	alignas(16) int64_t m_pairedRunWeights[4][MAX_WIDE_GRID_SIZE + 1][2] = {};
+	/// @brief m_planeWeights laid out as [plane][player] for the SSE4.1 kernel
+	alignas(16) int64_t m_pairedPlaneWeights[PLANE_COUNT][2] = {};
+	/// @brief m_valid for evaluateWide
+	BoardMask m_wideValid[4] = {};
+	/// @brief m_planes for evaluateWide
+	BoardMask m_widePlanes[2][PLANE_COUNT] = {};
+};
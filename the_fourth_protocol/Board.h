@@ -0,0 +1,178 @@
+/**
+ * @file Board.h
+ * @brief Compile-time sized bitboard rules for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the Board class template. A board of N x N cells with
+ * K in a row to win is one occupancy mask per player (bit row * N + col):
+ * a plain 64-bit integer up to 8x8, and the narrowest WideMask that holds
+ * the board above that. Every mask and shift is a compile-time constant, so
+ * the win checks compile to K - 1 unrolled shift-and steps per direction
+ * with no runtime size arithmetic. Each supported variant is one
+ * instantiation, listed in the Variants table.
+ */
+
+#pragma once
+#include <cstdint>
+#include "WideMask.h"
+
+/// @brief Compile-time mask helpers shared by every Board instantiation
+namespace BoardMasks {
+	/// @brief Build the mask of cells whose neighbour along a direction is on the board
+	/// @param size Grid size
+	/// @param dRow Row step
+	/// @param dCol Column step
+	/// @return Mask of cells with an on-board neighbour
+	constexpr uint64_t neighbours(int size, int dRow, int dCol)
+	{
+		uint64_t mask = 0;
+		for (int row = 0; row < size; ++row) {
+			for (int col = 0; col < size; ++col) {
+				int nextRow = row + dRow;
+				int nextCol = col + dCol;
+				if (nextRow >= 0 && nextRow < size && nextCol >= 0 && nextCol < size) {
+					mask |= 1ULL << (row * size + col);
+				}
+			}
+		}
+		return mask;
+	}
+
+	/// @brief Build the multi-word mask of cells whose neighbour along a direction is on the board
+	/// @tparam WORDS Number of 64-bit words of the mask
+	/// @param size Grid size
+	/// @param dRow Row step
+	/// @param dCol Column step
+	/// @return Mask of cells with an on-board neighbour
+	template <int WORDS>
+	constexpr WideMask<WORDS> wideNeighbours(int size, int dRow, int dCol)
+	{
+		WideMask<WORDS> mask = {};
+		for (int row = 0; row < size; ++row) {
+			for (int col = 0; col < size; ++col) {
+				int nextRow = row + dRow;
+				int nextCol = col + dCol;
+				if (nextRow >= 0 && nextRow < size && nextCol >= 0 && nextCol < size) {
+					mask.set(row * size + col);
+				}
+			}
+		}
+		return mask;
+	}
+
+	/// @brief Pick the single-word or multi-word neighbour mask for a mask type
+	template <int WORDS>
+	struct Neighbours {
+		static constexpr WideMask<WORDS> build(int size, int dRow, int dCol) { return wideNeighbours<WORDS>(size, dRow, dCol); }
+	};
+
+	template <>
+	struct Neighbours<1> {
+		static constexpr uint64_t build(int size, int dRow, int dCol) { return neighbours(size, dRow, dCol); }
+	};
+}
+
+/// @brief Bitboard rules for an N x N board won with K pieces in a row
+/// @tparam N Grid size (N * N must fit in a BoardMask)
+/// @tparam K Number of pieces in a row needed to win
+template <int N, int K>
+class Board
+{
+public:
+	static_assert(N * N <= BoardMask::BITS, "Board must fit in a BoardMask");
+	static_assert(K >= 2 && K <= N, "Win length must fit on the board");
+
+	/// @brief Grid size
+	static const int SIZE = N;
+	/// @brief Number of pieces in a row needed to win
+	static const int WIN_LENGTH = K;
+	/// @brief Number of cells
+	static const int CELLS = N * N;
+	/// @brief Number of 64-bit words in the occupancy mask
+	static const int WORDS = (CELLS + 63) / 64;
+
+	/// @brief Occupancy mask type: uint64_t up to 8x8, WideMask<WORDS> above
+	typedef typename MaskWords<WORDS>::type Mask;
+
+	/// @brief Check if a player's pieces contain K in a row
+	/// @param mask Occupancy mask of the player
+	/// @return True if the player has won
+	static bool hasWon(const Mask& mask)
+	{
+		return hasRun<1>(mask, HORIZONTAL) || hasRun<N>(mask, VERTICAL)
+			|| hasRun<N + 1>(mask, DIAGONAL) || hasRun<N - 1>(mask, ANTI_DIAGONAL);
+	}
+
+	/// @brief Check if a player's pieces contain K in a row, narrowing a full-width mask first
+	/// @param mask Occupancy mask of the player (bits past CELLS must be clear)
+	/// @return True if the player has won
+	static bool hasWonBoard(const BoardMask& mask) { return hasWon(MaskWords<WORDS>::from(mask)); }
+
+	/// @brief Check if a player's pieces contain K in a row through one cell
+	///
+	/// Only the player who just moved can have completed a line, and only
+	/// through the cell the piece landed on, so this is the check made after
+	/// every move.
+	/// @param mask Occupancy mask of the player
+	/// @param cell Row-major cell index the line must pass through
+	/// @return True if a winning line passes through the cell
+	static bool completesLine(const Mask& mask, int cell)
+	{
+		const Mask piece = MaskWords<WORDS>::bit(cell);
+		return hasRunThrough<1>(mask, piece, HORIZONTAL) || hasRunThrough<N>(mask, piece, VERTICAL)
+			|| hasRunThrough<N + 1>(mask, piece, DIAGONAL) || hasRunThrough<N - 1>(mask, piece, ANTI_DIAGONAL);
+	}
+
+	/// @brief Check for K in a row through one cell, narrowing a full-width mask first
+	/// @param mask Occupancy mask of the player (bits past CELLS must be clear)
+	/// @param cell Row-major cell index the line must pass through
+	/// @return True if a winning line passes through the cell
+	static bool completesLineBoard(const BoardMask& mask, int cell) { return completesLine(MaskWords<WORDS>::from(mask), cell); }
+
+private:
+	/// @brief Cells whose right-hand neighbour is on the board
+	static constexpr Mask HORIZONTAL = BoardMasks::Neighbours<WORDS>::build(N, 0, 1);
+	/// @brief Cells whose lower neighbour is on the board
+	static constexpr Mask VERTICAL = BoardMasks::Neighbours<WORDS>::build(N, 1, 0);
+	/// @brief Cells whose lower-right neighbour is on the board
+	static constexpr Mask DIAGONAL = BoardMasks::Neighbours<WORDS>::build(N, 1, 1);
+	/// @brief Cells whose lower-left neighbour is on the board
+	static constexpr Mask ANTI_DIAGONAL = BoardMasks::Neighbours<WORDS>::build(N, 1, -1);
+
+	/// @brief Check for K in a row along one direction
+	/// @tparam STEP Bit distance to the next cell along the direction
+	/// @param mask Occupancy mask of the player
+	/// @param valid Cells whose next cell along the direction is on the board
+	/// @return True if some cell starts K in a row
+	template <int STEP>
+	static bool hasRun(const Mask& mask, const Mask& valid)
+	{
+		// After i steps, a set bit starts i + 1 pieces in a row
+		Mask runs = mask;
+		for (int i = 1; i < K; ++i) {
+			runs &= (runs >> STEP) & valid;
+		}
+		return MaskWords<WORDS>::any(runs);
+	}
+
+	/// @brief Check for K in a row along one direction that covers a given cell
+	/// @tparam STEP Bit distance to the next cell along the direction
+	/// @param mask Occupancy mask of the player
+	/// @param piece Mask holding only the cell
+	/// @param valid Cells whose next cell along the direction is on the board
+	/// @return True if some run of K covers the cell
+	template <int STEP>
+	static bool hasRunThrough(const Mask& mask, const Mask& piece, const Mask& valid)
+	{
+		// A run covering the cell starts at most K - 1 steps before it on the same line
+		Mask runs = mask;
+		Mask starts = piece;
+		for (int i = 1; i < K; ++i) {
+			runs &= (runs >> STEP) & valid;
+			starts |= (starts >> STEP) & valid;
+		}
+		return MaskWords<WORDS>::any(runs & starts);
+	}
+};
@@ -0,0 +1,61 @@
+#include "DecisionLog.h"
+#include <utility>
+
+DecisionLog::~DecisionLog()
+{
+	close();
+}
+
+bool DecisionLog::open(const std::string& path)
+{
+	close();
+
+	m_file.open(path, std::ios::app);
+	if (!m_file.is_open()) return false;
+
+	m_closing = false;
+	m_writer = std::thread(&DecisionLog::runWriter, this);
+	return true;
+}
+
+void DecisionLog::close()
+{
+	if (!m_writer.joinable()) return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_closing = true;
+	}
+	m_wake.notify_one();
+	m_writer.join();
+	m_file.close();
+}
+
+void DecisionLog::append(std::string line)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_queue.push_back(std::move(line));
+	}
+	m_wake.notify_one();
+}
+
+void DecisionLog::runWriter()
+{
+	std::vector<std::string> batch;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [this]() { return m_closing || !m_queue.empty(); });
+			if (m_queue.empty()) return; // closing with nothing left to write
+			batch.swap(m_queue);
+		}
+
+		// The lock is free while the disk is busy, so append never waits on it
+		for (const std::string& line : batch) {
+			m_file << line << '\n';
+		}
+		m_file.flush();
+		batch.clear();
+	}
+}
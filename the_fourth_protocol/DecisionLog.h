@@ -0,0 +1,68 @@
+/**
+ * @file DecisionLog.h
+ * @brief Append-only JSON-lines log written on a background thread
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the DecisionLog class, which appends one record per
+ * line to a file for offline analysis of AI decisions. Callers hand over
+ * finished lines; a writer thread owns the file, so a slow disk never holds
+ * up the game loop or the turbo thread. Lines still queued when the log is
+ * closed are written before the file is closed.
+ */
+
+#pragma once
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Line log whose file writes happen on its own thread
+class DecisionLog
+{
+public:
+	/// @brief Default constructor creating a closed log
+	DecisionLog() = default;
+
+	/// @brief Destructor writing any queued lines and closing the file
+	~DecisionLog();
+
+	DecisionLog(const DecisionLog&) = delete;
+	DecisionLog& operator=(const DecisionLog&) = delete;
+
+	/// @brief Open a log file for appending and start the writer thread
+	/// @param path Path of the log file (created if missing)
+	/// @return True if the file was opened, false otherwise (the log stays closed)
+	bool open(const std::string& path);
+
+	/// @brief Write the queued lines, stop the writer thread and close the file
+	void close();
+
+	/// @brief Check if lines are being logged
+	/// @return True between a successful open and close
+	bool isOpen() const { return m_writer.joinable(); }
+
+	/// @brief Queue a line for the writer thread; returns without touching the file
+	/// @param line Record without the trailing newline
+	void append(std::string line);
+
+private:
+	/// @brief Writer thread: write queued lines in batches until closed
+	void runWriter();
+
+	/// @brief Log file, used only by the writer thread while it runs
+	std::ofstream m_file;
+	/// @brief Thread writing the queued lines
+	std::thread m_writer;
+	/// @brief Guards m_queue and m_closing
+	std::mutex m_mutex;
+	/// @brief Wakes the writer when lines are queued or the log closes
+	std::condition_variable m_wake;
+	/// @brief Lines waiting to be written
+	std::vector<std::string> m_queue;
+	/// @brief True once close has been asked for
+	bool m_closing = false;
+};
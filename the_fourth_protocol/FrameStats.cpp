@@ -0,0 +1,60 @@
+#include "FrameStats.h"
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace {
+	/// @brief Column name of each metric in the histogram file
+	const char* const METRIC_NAMES[] = { "update", "render", "present", "input_latency" };
+}
+
+void FrameStats::record(Metric metric, float milliseconds)
+{
+	m_samples[metric][m_next[metric]] = milliseconds;
+	m_next[metric] = (m_next[metric] + 1) % CAPACITY;
+	m_count[metric] = std::min(m_count[metric] + 1, CAPACITY);
+
+	const int bucket = std::min(static_cast<int>(std::max(milliseconds, 0.0f) / BUCKET_MS), BUCKET_COUNT);
+	++m_histogram[metric][bucket];
+}
+
+float FrameStats::sample(Metric metric, int age) const
+{
+	return m_samples[metric][(m_next[metric] - 1 - age + CAPACITY) % CAPACITY];
+}
+
+float FrameStats::percentile(Metric metric, float percent) const
+{
+	const int count = m_count[metric];
+	if (count == 0) return 0.0f;
+
+	// The ring buffer is only partly filled until CAPACITY samples have been recorded
+	std::vector<float> sorted(m_samples[metric], m_samples[metric] + count);
+	const int rank = std::min(count - 1, static_cast<int>(percent / 100.0f * count));
+	std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+	return sorted[rank];
+}
+
+bool FrameStats::writeHistogram(const std::string& path) const
+{
+	std::ofstream out(path, std::ios::trunc);
+	if (!out) return false;
+
+	for (int metric = 0; metric < METRIC_COUNT; ++metric) {
+		uint64_t total = 0;
+		for (int bucket = 0; bucket <= BUCKET_COUNT; ++bucket) total += m_histogram[metric][bucket];
+		const Metric m = static_cast<Metric>(metric);
+		out << "# " << METRIC_NAMES[metric] << ": " << total << " samples, recent p50 " << percentile(m, 50.0f)
+			<< " ms, p95 " << percentile(m, 95.0f) << " ms, p99 " << percentile(m, 99.0f) << " ms\n";
+	}
+
+	out << "bucket_ms";
+	for (int metric = 0; metric < METRIC_COUNT; ++metric) out << "," << METRIC_NAMES[metric];
+	out << "\n";
+	for (int bucket = 0; bucket <= BUCKET_COUNT; ++bucket) {
+		out << bucket * BUCKET_MS;
+		for (int metric = 0; metric < METRIC_COUNT; ++metric) out << "," << m_histogram[metric][bucket];
+		out << "\n";
+	}
+	return static_cast<bool>(out);
+}
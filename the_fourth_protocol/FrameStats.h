@@ -0,0 +1,81 @@
+/**
+ * @file FrameStats.h
+ * @brief Frame timing statistics for the performance overlay
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the FrameStats class, which records how long each
+ * rendered frame spent updating, rendering and presenting, and the delay
+ * from a drag movement to the frame that shows it. The last CAPACITY
+ * samples of each metric are kept in a ring buffer for percentiles and the
+ * overlay graph. Every sample of the run also goes into a fixed-bucket
+ * histogram, which can be written as CSV on exit to check frame pacing on
+ * deployed machines.
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+/// @brief Ring buffers and histograms of per-frame timings
+class FrameStats
+{
+public:
+	/// @brief What a sample measures
+	enum Metric {
+		Update,			///< Fixed-step updates run since the previous frame
+		Render,			///< Drawing the frame
+		Present,		///< Displaying the frame (window.display(), including any vsync wait)
+		InputLatency,	///< From handling a drag movement to displaying the frame that shows it
+		METRIC_COUNT
+	};
+
+	/// @brief Samples kept per metric for percentiles and the graph
+	static constexpr int CAPACITY = 600;
+	/// @brief Width of a histogram bucket in milliseconds
+	static constexpr float BUCKET_MS = 0.5f;
+	/// @brief Number of histogram buckets; longer samples go to one overflow bucket
+	static constexpr int BUCKET_COUNT = 200;
+
+	/// @brief Record a sample
+	/// @param metric What was measured
+	/// @param milliseconds Measured time
+	void record(Metric metric, float milliseconds);
+
+	/// @brief Get the number of samples in the ring buffer
+	/// @param metric Metric to count
+	/// @return Samples available, at most CAPACITY
+	int sampleCount(Metric metric) const { return m_count[metric]; }
+
+	/// @brief Get a recent sample
+	/// @param metric Metric to read
+	/// @param age 0 for the newest sample, up to sampleCount() - 1 for the oldest
+	/// @return Sample in milliseconds
+	float sample(Metric metric, int age) const;
+
+	/// @brief Get a percentile of the samples in the ring buffer
+	/// @param metric Metric to summarise
+	/// @param percent Percentile, such as 50, 95 or 99
+	/// @return Sample at that percentile in milliseconds (0 if there are no samples)
+	float percentile(Metric metric, float percent) const;
+
+	/// @brief Write the whole run's histograms as CSV
+	///
+	/// Comment lines starting with '#' give the sample count and the recent
+	/// percentiles of each metric. Each row after the header holds the lower
+	/// edge of a bucket and the sample count of every metric in it.
+	/// @param path File to write
+	/// @return False if the file could not be written
+	bool writeHistogram(const std::string& path) const;
+
+private:
+	/// @brief Recent samples of each metric, oldest overwritten first
+	float m_samples[METRIC_COUNT][CAPACITY] = {};
+	/// @brief Slot the next sample of each metric goes into
+	int m_next[METRIC_COUNT] = {};
+	/// @brief Samples in each ring buffer
+	int m_count[METRIC_COUNT] = {};
+	/// @brief Samples of the whole run per bucket, the last bucket holding everything longer
+	uint32_t m_histogram[METRIC_COUNT][BUCKET_COUNT + 1] = {};
+};
@@ -1,34 +1,116 @@
 #include "Game.h"
+#include "AllocationTracker.h"
+#include "MoveNotation.h"
+#include "RenderBatch.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <chrono>
 
 // Our target FPS
 static double const FPS{ 60.0f };
+// Longest wait for input while idle, so the loop still looks around now and then
+static int const IDLE_TIMEOUT_MS{ 250 };
+
+namespace {
+	/// @brief Label of a playback speed for the speed button and the status line
+	const char* turboSpeedLabel(Game::TurboSpeed speed)
+	{
+		switch (speed) {
+			case Game::TurboSpeed::Fast:
+				return "10x";
+			case Game::TurboSpeed::Max:
+				return "max";
+			default:
+				return "1x";
+		}
+	}
+
+	/// @brief Names of the strategies in the decision log, indexed by static_cast<int>(Strategy)
+	const char* const STRATEGY_NAMES[] = { "Balanced", "FavorDiagonal", "FavorCenter", "FavorEdges", "Aggressive", "Defensive" };
+	/// @brief Names of the difficulties in the decision log, indexed by static_cast<int>(Difficulty)
+	const char* const DIFFICULTY_NAMES[] = { "Easy", "Medium", "Hard" };
+	/// @brief Alternative root moves kept for the decision log
+	const int MAX_ALTERNATIVES = 3;
+
+	/// @brief Check if two moves are the same
+	bool sameMove(const Move& a, const Move& b)
+	{
+		return a.pieceIndex == b.pieceIndex && a.fromRow == b.fromRow && a.fromCol == b.fromCol
+			&& a.toRow == b.toRow && a.toCol == b.toCol;
+	}
+
+	/// @brief Write a count briefly, with a k or M suffix above 999
+	std::string compactCount(uint64_t count)
+	{
+		if (count < 1000) return std::to_string(count);
+
+		const bool millions = count >= 1000000;
+		const double scaled = millions ? count / 1e6 : count / 1e3;
+		std::ostringstream oss;
+		oss << std::fixed << std::setprecision(scaled < 10.0 ? 1 : 0) << scaled << (millions ? 'M' : 'k');
+		return oss.str();
+	}
+}
 
 ////////////////////////////////////////////////////////////
-Game::Game()
+Game::Game(const LaunchOptions& options)
 	: m_window(sf::VideoMode(sf::Vector2u(ScreenSize::s_width, ScreenSize::s_height), 32), "The Fourth Protocol", sf::Style::Default),
 	m_menu(m_arialFont, sf::Vector2f(static_cast<float>(ScreenSize::s_width), static_cast<float>(ScreenSize::s_height)))
 {
+	Trace::Zone zone("load assets");
+
+	// The analysis cache and opening book are optional, so a missing file just means every move is searched
+	if (!options.analysisCachePath.empty()) {
+		m_ai.openAnalysisCache(options.analysisCachePath);
+	}
+	if (!options.openingBookPath.empty()) {
+		m_ai.openOpeningBook(options.openingBookPath);
+	}
+	if (!options.variant.empty()) {
+		m_forcedVariant = Variants::find(options.variant);
+		if (m_forcedVariant < 0) {
+			std::cout << "Unknown variant " << options.variant << ", using the difficulty's board\n";
+		}
+	}
+	if (!options.analysisJournalPath.empty() && !m_ai.openAnalysisJournal(options.analysisJournalPath)) {
+		std::cout << "Error opening analysis journal " << options.analysisJournalPath << "\n";
+	}
+	if (!options.decisionLogPath.empty() && !m_decisionLog.open(options.decisionLogPath)) {
+		std::cout << "Error opening decision log " << options.decisionLogPath << "\n";
+	}
+	m_maxMoves = options.maxMoves;
+	m_useNodeBudgets = options.nodeBudgets;
+	m_frameStatsPath = options.frameStatsPath;
+	m_sceneLayerReady = m_sceneLayer.resize(sf::Vector2u(ScreenSize::s_width, ScreenSize::s_height));
+	if (!m_sceneLayerReady) {
+		std::cout << "Error creating the scene layer, drawing every frame in full\n";
+	}
+	// The pre-decoded pack skips PNG decoding; the images themselves still work without it
+	if (options.pieceAtlasPath.empty() || !m_pieceAtlas.openPack(options.pieceAtlasPath)) {
+		m_pieceAtlas.loadImages("ASSETS/IMAGES/");
+	}
+
 	init();
 }
 
+////////////////////////////////////////////////////////////
+Game::~Game()
+{
+	stopTurbo(false);
+}
+
 ////////////////////////////////////////////////////////////
 void Game::init()
 {
+	// A new game never continues the previous one's simulation
+	stopTurbo(false);
+
 #pragma region NOT GOING TO NEED TO SEE THESE
 
 	// Really only necessary is our target FPS is greater than 60.
 	m_window.setVerticalSyncEnabled(true);
-	
-	if (!m_arialFont.getInfo().family.size()) {
-		// only try to open if font is not already loaded
-		if (!m_arialFont.openFromFile("ASSETS/FONTS/ariblk.ttf"))
-		{
-			std::cout << "Error loading font file";
-		}
-	}
 
 #ifdef TEST_FPS
 	x_updateFPS.setFont(m_arialFont);
@@ -45,11 +127,7 @@ void Game::init()
 	configureDifficulty();
 
 	// reset board and state
-	m_board.clear();
-	m_board.resize(m_gridRows);
-	for (int i = 0; i < m_gridRows; ++i) {
-		m_board[i].resize(m_gridCols, nullptr);
-	}
+	m_board.reset(m_gridRows);
 
 	m_grid.clear();
 	m_p1Grid.clear();
@@ -63,23 +141,26 @@ void Game::init()
 	m_p1PiecesPlaced = 0;
 	m_p2PiecesPlaced = 0;
 	m_winner = nullptr;
+	m_positionHistory.clear();
 	m_selectedPiece = nullptr;
 	m_isDragging = false;
 	m_validMoveIndicators.clear();
+	m_boardDirty = true;
+	m_sceneDirty = true;
 	m_aiThinking = false;
 	m_aiThinkTime = 0.0;
 	m_lastMove = Move();
 	m_lastMoveP1 = Move();
 	m_lastMoveP2 = Move();
 
-	const float cellSizeXY = 100.0f;
+	const float cellSizeXY = getCellSize();
 	const int gridSizeXY = m_gridRows * cellSizeXY;
 	const float x0 = 0.5f * (static_cast<float>(ScreenSize::s_width) - gridSizeXY); // grid x origin pos
 	const float y0 = 0.5f * (static_cast<float>(ScreenSize::s_height) - gridSizeXY); // grid y origin pos
 
 	m_grid.resize(m_gridRows * m_gridCols);
 	
-	int numPieces = (m_difficulty == Difficulty::Hard) ? 7 : 5;
+	int numPieces = Variants::get(m_variant).pieceCount;
 	m_p1Grid.resize(numPieces);
 	m_p2Grid.resize(numPieces);
 	
@@ -97,6 +178,9 @@ void Game::init()
 		}
 	}
 
+	// Both players' pieces start off the board, with Player 1 to move
+	m_position = Position::fromBoard(m_board, m_variant, m_p1Pieces, m_p2Pieces, true);
+
 #pragma region text and button setup
 
 
@@ -115,7 +199,7 @@ void Game::init()
 
 	{
 		float panelWidth = 500.0f;
-		float panelHeight = 320.0f;
+		float panelHeight = 480.0f;
 		float panelX = ScreenSize::s_width - panelWidth - 20.0f;
 		float panelY = 20.0f;
 
@@ -150,6 +234,10 @@ void Game::init()
 		m_aiTimeText.setFillColor(sf::Color::White);
 		m_aiTimeText.setPosition({ panelX + 15.0f, panelY + 280.0f });
 
+		m_aiSearchStatsText.setCharacterSize(16);
+		m_aiSearchStatsText.setFillColor(sf::Color(200, 200, 200));
+		m_aiSearchStatsText.setPosition({ panelX + 15.0f, panelY + 320.0f });
+
 		m_aiMoveFromIndicator.setSize({ cellSizeXY, cellSizeXY });
 		m_aiMoveFromIndicator.setFillColor(sf::Color::Transparent);
 		m_aiMoveFromIndicator.setOutlineThickness(4.0f);
@@ -163,111 +251,68 @@ void Game::init()
 		m_aiMoveToIndicator.setPosition({ -1000.0f, -1000.0f });
 	}
 
+	{
+		float panelWidth = 500.0f;
+		float panelHeight = 250.0f;
+		float panelX = ScreenSize::s_width - panelWidth - 20.0f;
+		float panelY = ScreenSize::s_height - panelHeight - 20.0f;
+
+		m_frameStatsPanel.setSize({ panelWidth, panelHeight });
+		m_frameStatsPanel.setPosition({ panelX, panelY });
+		m_frameStatsPanel.setFillColor(sf::Color(30, 30, 30, 220));
+		m_frameStatsPanel.setOutlineThickness(3.0f);
+		m_frameStatsPanel.setOutlineColor(sf::Color(255, 200, 100));
+
+		m_frameStatsText.setCharacterSize(16);
+		m_frameStatsText.setFillColor(sf::Color::White);
+		m_frameStatsText.setPosition({ panelX + 10.0f, panelY + 8.0f });
+	}
+
 }
 
 void Game::setupPieces(vector<Piece>& pieces, int row, const float cellSize, Vector2f startPos, bool isP1)
 {
-	if (row == 0) pieces.push_back(Piece(Piece::Type::Frog, m_frogTexture, cellSize, startPos, isP1));
-	else if (row == 1) pieces.push_back(Piece(Piece::Type::Snake, m_snakeTexture, cellSize, startPos, isP1));
-	else if (row == 2 || row == 3 || row == 4) {
-		pieces.push_back(Piece(Piece::Type::Donkey, m_donkeyTexture, cellSize, startPos, isP1));
-	}
-	else if (row == 5 && m_difficulty == Difficulty::Hard) {
-		pieces.push_back(Piece(Piece::Type::Antelope, m_antelopeTexture, cellSize, startPos, isP1));
-	}
-	else if (row == 6 && m_difficulty == Difficulty::Hard) {
-		pieces.push_back(Piece(Piece::Type::Lion, m_lionTexture, cellSize, startPos, isP1));
-	}
-}
+	if (row >= Variants::get(m_variant).pieceCount) return;
 
-void Game::updateBoard() {
-	for (int row = 0; row < m_gridRows; ++row) {
-		for (int col = 0; col < m_gridCols; ++col) {
-			m_board[row][col] = nullptr;
-		}
-	}
+	const Piece::Type type = Variants::pieceType(row);
+	pieces.push_back(Piece(type, m_pieceAtlas.getTexture(), m_pieceAtlas.getRect(type), cellSize, startPos, isP1));
+}
 
-	for (auto& piece : m_p1Pieces) {
-		if (piece.getGridRow() >= 0 && piece.getGridCol() >= 0) {
-			m_board[piece.getGridRow()][piece.getGridCol()] = &piece;
-		}
-	}
+int Game::getPieceIndex(const Piece* piece) const {
+	const vector<Piece>& pieces = piece->isPlayer1() ? m_p1Pieces : m_p2Pieces;
+	return static_cast<int>(piece - pieces.data());
+}
 
-	for (auto& piece : m_p2Pieces) {
-		if (piece.getGridRow() >= 0 && piece.getGridCol() >= 0) {
-			m_board[piece.getGridRow()][piece.getGridCol()] = &piece;
-		}
+vector<pair<int, int>> Game::getValidMoves(const Piece& piece) const {
+	vector<pair<int, int>> validMoves;
+	int16_t targets[Position::MAX_TARGETS];
+	int count = m_position.getTargets(Position::sideOf(piece.isPlayer1()), getPieceIndex(&piece), targets);
+	for (int i = 0; i < count; ++i) {
+		validMoves.push_back(make_pair(targets[i] / m_gridCols, targets[i] % m_gridCols));
 	}
+	return validMoves;
 }
 
 Piece* Game::getPieceAtGridPosition(int row, int col) {
 	if (row < 0 || row >= m_gridRows || col < 0 || col >= m_gridCols) return nullptr;
-	return m_board[row][col];
-}
-
-bool Game::checkWinCondition(bool isPlayer1) {
-	// Horizontal
-	for (int row = 0; row < m_gridRows; ++row) {
-		for (int col = 0; col < m_gridCols - 3; ++col) {
-			if (m_board[row][col] && m_board[row][col]->isPlayer1() == isPlayer1 &&
-				m_board[row][col + 1] && m_board[row][col + 1]->isPlayer1() == isPlayer1 &&
-				m_board[row][col + 2] && m_board[row][col + 2]->isPlayer1() == isPlayer1 &&
-				m_board[row][col + 3] && m_board[row][col + 3]->isPlayer1() == isPlayer1) {
-				return true;
-			}
-		}
-	}
-
-	// Vertical
-	for (int col = 0; col < m_gridCols; ++col) {
-		for (int row = 0; row < m_gridRows - 3; ++row) {
-			if (m_board[row][col] && m_board[row][col]->isPlayer1() == isPlayer1 &&
-				m_board[row + 1][col] && m_board[row + 1][col]->isPlayer1() == isPlayer1 &&
-				m_board[row + 2][col] && m_board[row + 2][col]->isPlayer1() == isPlayer1 &&
-				m_board[row + 3][col] && m_board[row + 3][col]->isPlayer1() == isPlayer1) {
-				return true;
-			}
-		}
-	}
-
-	// Diagonal (top-left to bottom-right)
-	for (int row = 0; row < m_gridRows - 3; ++row) {
-		for (int col = 0; col < m_gridCols - 3; ++col) {
-			if (m_board[row][col] && m_board[row][col]->isPlayer1() == isPlayer1 &&
-				m_board[row + 1][col + 1] && m_board[row + 1][col + 1]->isPlayer1() == isPlayer1 &&
-				m_board[row + 2][col + 2] && m_board[row + 2][col + 2]->isPlayer1() == isPlayer1 &&
-				m_board[row + 3][col + 3] && m_board[row + 3][col + 3]->isPlayer1() == isPlayer1) {
-				return true;
-			}
-		}
-	}
-
-	// Diagonal (top-right to bottom-left)
-	for (int row = 0; row < m_gridRows - 3; ++row) {
-		for (int col = 3; col < m_gridCols; ++col) {
-			if (m_board[row][col] && m_board[row][col]->isPlayer1() == isPlayer1 &&
-				m_board[row + 1][col - 1] && m_board[row + 1][col - 1]->isPlayer1() == isPlayer1 &&
-				m_board[row + 2][col - 2] && m_board[row + 2][col - 2]->isPlayer1() == isPlayer1 &&
-				m_board[row + 3][col - 3] && m_board[row + 3][col - 3]->isPlayer1() == isPlayer1) {
-				return true;
-			}
-		}
-	}
-
-	return false;
+	return m_board.at(row, col);
 }
 
 bool Game::isValidPlacement(int row, int col) {
 	if (row < 0 || row >= m_gridRows || col < 0 || col >= m_gridCols) return false;
-	if (m_board[row][col] != nullptr) return false;
+	if (m_board.at(row, col) != nullptr) return false;
 	return true;
 }
 
 bool Game::placePiece(Piece* piece, int row, int col) {
 	if (!isValidPlacement(row, col)) return false;
 
+	Rules::Outcome outcome = Rules::placePiece(m_position, Position::sideOf(piece->isPlayer1()),
+		getPieceIndex(piece), m_board.index(row, col));
+	if (outcome == Rules::Outcome::Illegal) return false;
+
 	piece->setGridPosition(row, col);
-	m_board[row][col] = piece;
+	m_board.at(row, col) = piece;
 
 	if (piece->isPlayer1()) {
 		m_p1PiecesPlaced++;
@@ -275,7 +320,7 @@ bool Game::placePiece(Piece* piece, int row, int col) {
 		m_p2PiecesPlaced++;
 	}
 
-	if (checkWinCondition(piece->isPlayer1())) {
+	if (outcome == Rules::Outcome::Won) {
         handleWinLogic(piece);
         return true;
 	}
@@ -296,21 +341,51 @@ void Game::handleWinLogic(Piece *piece)
     {
         winnerText = piece->isPlayer1() ? "Player 1 Wins!" : (m_isAIGame ? "AI Wins!" : "Player 2 Wins!");
     }
-    m_menu.showGameOver(winnerText + " - 4 in a row!");
+    m_menu.showGameOver(winnerText + " - " + std::to_string(Variants::get(m_variant).winLength) + " in a row!");
+}
+
+void Game::handleDraw(const std::string& reason)
+{
+	m_gamePhase = GamePhase::GameOver;
+	m_winner = nullptr;
+	m_menu.showGameOver("Draw - " + reason);
+}
+
+void Game::handleNoMove(bool player1Won)
+{
+	m_gamePhase = GamePhase::GameOver;
+	m_winner = nullptr;
+	std::string winnerText;
+	std::string loserText;
+	if (m_isAIvsAI)
+	{
+		winnerText = player1Won ? "AI 1 (Red) Wins!" : "AI 2 (Blue) Wins!";
+		loserText = player1Won ? "AI 2" : "AI 1";
+	}
+	else
+	{
+		winnerText = player1Won ? "Player 1 Wins!" : (m_isAIGame ? "AI Wins!" : "Player 2 Wins!");
+		loserText = player1Won ? (m_isAIGame ? "AI" : "Player 2") : "Player 1";
+	}
+	m_menu.showGameOver(winnerText + " - " + loserText + " has no legal move");
 }
 
 bool Game::movePiece(Piece* piece, int fromRow, int fromCol, int toRow, int toCol) {
-	if (!piece->isValidMove(toRow, toCol, m_board, m_gridRows)) {
+	if (!m_board.contains(toRow, toCol)) return false;
+
+	Rules::Outcome outcome = Rules::movePiece(m_position, Position::sideOf(piece->isPlayer1()),
+		getPieceIndex(piece), m_board.index(toRow, toCol));
+	if (outcome == Rules::Outcome::Illegal) {
 		return false;
 	}
 
-	// Update board
-	m_board[fromRow][fromCol] = nullptr;
-	m_board[toRow][toCol] = piece;
+	// Update board in place: only the two cells the piece left and entered change
+	m_board.at(fromRow, fromCol) = nullptr;
+	m_board.at(toRow, toCol) = piece;
 	piece->setGridPosition(toRow, toCol);
 
 	// Check for win
-	if (checkWinCondition(piece->isPlayer1())) {
+	if (outcome == Rules::Outcome::Won) {
 		handleWinLogic(piece);
 		return true;
 	}
@@ -339,7 +414,7 @@ void Game::endTurn() {
 		m_instructionText.setString("AI vs AI - Watch the game unfold!");
 	}
 
-	int totalPieces = (m_difficulty == Difficulty::Hard) ? 7 : 5;
+	int totalPieces = Variants::get(m_variant).pieceCount;
 	if (m_gamePhase == GamePhase::Placement && m_p1PiecesPlaced == totalPieces && m_p2PiecesPlaced == totalPieces) {
 		m_gamePhase = GamePhase::Movement;
 		m_isPlayer1Turn = true;
@@ -354,25 +429,61 @@ void Game::endTurn() {
 			m_instructionText.setString("Click and drag pieces to move them");
 		}
 	}
+
+	m_position.player1ToMove = m_isPlayer1Turn;
+	m_position.placementPhase = m_gamePhase == GamePhase::Placement;
+	if (m_gamePhase != GamePhase::Movement) return;
+
+	// The first movement-phase position is recorded too, since the pieces can return to it
+	m_positionHistory.push(m_position.repetitionKey());
+	const int movesPlayed = m_positionHistory.size() - 1;
+	if (m_positionHistory.isRepetitionDraw(m_position.repetitionKey())) {
+		handleDraw("threefold repetition");
+	} else if (m_maxMoves > 0 && movesPlayed >= m_maxMoves) {
+		handleDraw(std::to_string(m_maxMoves) + " move limit reached");
+	}
 }
 
 #pragma region NEVER GONNA TOUCH 
 ////////////////////////////////////////////////////////////
 void Game::run()
 {
+	Trace::Zone zone("Game::run");
 	sf::Clock clock;
 	sf::Time timeSinceLastUpdate = sf::Time::Zero;
 	
 	sf::Time timePerFrame = sf::seconds(1.0f / FPS); // 60 fps
 	while (m_window.isOpen())
 	{
+		if (isIdle())
+		{
+			// Nothing moves by itself, so sleep until there is input instead of spinning
+			if (const std::optional event = m_window.waitEvent(sf::milliseconds(IDLE_TIMEOUT_MS)))
+			{
+				handleEvent(*event);
+			}
+			processEvents(); // whatever else queued up meanwhile
+			const sf::Time updateStart = m_frameTimer.getElapsedTime();
+			update(timePerFrame.asMilliseconds()); // one update for the new input, no catching up on the wait
+			m_pendingUpdateTime += m_frameTimer.getElapsedTime() - updateStart;
+			timeSinceLastUpdate = sf::Time::Zero;
+			clock.restart();
+			if (m_sceneDirty)
+			{
+				render(); // only when something changed
+			}
+			continue;
+		}
+
 		processEvents(); // as many as possible
 		timeSinceLastUpdate += clock.restart();
 		while (timeSinceLastUpdate > timePerFrame)
 		{
 			timeSinceLastUpdate -= timePerFrame;
 			processEvents(); // at least 60 fps
+			const sf::Time updateStart = m_frameTimer.getElapsedTime();
 			update(timePerFrame.asMilliseconds()); //60 fps
+			m_pendingUpdateTime += m_frameTimer.getElapsedTime() - updateStart;
 #ifdef TEST_FPS
 			x_secondTime += timePerFrame;
 			x_updateFrameCount++;
@@ -393,21 +504,54 @@ void Game::run()
 		x_drawFrameCount++;
 #endif
 	}
+
+	if (!m_frameStatsPath.empty() && !m_frameStats.writeHistogram(m_frameStatsPath)) {
+		std::cout << "Error writing frame stats to " << m_frameStatsPath << "\n";
+	}
 }
 
 ////////////////////////////////////////////////////////////
 void Game::processEvents()
 {
+	Trace::Zone zone("Game::processEvents");
     while (const std::optional event = m_window.pollEvent())
     {
-        if (event->is<sf::Event::Closed>())
-        {
-            m_window.close();
-        }
-        processGameEvents(*event);
+        handleEvent(*event);
     }
 }
 
+////////////////////////////////////////////////////////////
+void Game::handleEvent(const sf::Event& event)
+{
+    if (event.is<sf::Event::Closed>())
+    {
+        m_window.close();
+    }
+    // While dragging, mouse movement only moves the dragged piece, which is drawn over the layer
+    if (!m_isDragging || !event.is<sf::Event::MouseMoved>())
+    {
+        m_sceneDirty = true;
+    }
+    processGameEvents(event);
+}
+
+////////////////////////////////////////////////////////////
+bool Game::isIdle() const
+{
+    // Drags, AI searches and AI vs AI playback all need the full-rate loop
+    if (m_isDragging || m_aiThinking || m_turboThread.joinable())
+    {
+        return false;
+    }
+    // An AI about to move starts thinking on the next update
+    if (m_isAIGame && m_menu.getState() == Menu::State::Hidden && m_gamePhase != GamePhase::GameOver &&
+        (m_isAIvsAI || !m_isPlayer1Turn))
+    {
+        return false;
+    }
+    return true;
+}
+
 
 ////////////////////////////////////////////////////////////
 void Game::processGameEvents(const sf::Event& event)
@@ -429,6 +573,10 @@ void Game::processGameEvents(const sf::Event& event)
 			m_aiDelayEnabled = !m_aiDelayEnabled;
 			return;
 		}
+		if (keyPressed->scancode == sf::Keyboard::Scancode::P) {
+			m_showFrameStats = !m_showFrameStats;
+			return;
+		}
 	}
 
 	// If the main menu is visible, handle menu clicks and ignore other game events
@@ -510,7 +658,29 @@ void Game::processGameEvents(const sf::Event& event)
 	}
 
 	if (m_isAIvsAI && (m_gamePhase == GamePhase::Placement || m_gamePhase == GamePhase::Movement)) {
-		return; // In AI vs AI mode, block all player input during game
+		// In AI vs AI mode, only the playback controls take input during the game
+		if (const auto* mousePressed = event.getIf<sf::Event::MouseButtonPressed>()) {
+			if (mousePressed->button == sf::Mouse::Button::Left) {
+				Vector2f mousePos = m_window.mapPixelToCoords(
+					Vector2i(mousePressed->position.x, mousePressed->position.y)
+				);
+				if (m_turboSpeedButton.contains(mousePos)) {
+					setTurboSpeed(m_turboSpeed == TurboSpeed::Normal ? TurboSpeed::Fast
+						: m_turboSpeed == TurboSpeed::Fast ? TurboSpeed::Max : TurboSpeed::Normal);
+				} else if (m_skipButton.contains(mousePos)) {
+					skipToResult();
+				}
+			}
+		}
+		if (const auto* keyPressedT = event.getIf<sf::Event::KeyPressed>()) {
+			if (keyPressedT->scancode == sf::Keyboard::Scancode::T) {
+				setTurboSpeed(m_turboSpeed == TurboSpeed::Normal ? TurboSpeed::Fast
+					: m_turboSpeed == TurboSpeed::Fast ? TurboSpeed::Max : TurboSpeed::Normal);
+			} else if (keyPressedT->scancode == sf::Keyboard::Scancode::S) {
+				skipToResult();
+			}
+		}
+		return;
 	}
 	
 	if (m_isAIGame && !m_isAIvsAI && !m_isPlayer1Turn && (m_gamePhase == GamePhase::Placement || m_gamePhase == GamePhase::Movement)) {
@@ -555,10 +725,10 @@ void Game::processGameEvents(const sf::Event& event)
 						
 						// Show valid move previews if in movement phase and piece is on board
 						if (m_gamePhase == GamePhase::Movement && piece.getGridRow() >= 0) {
-							auto validMoves = piece.getValidMoves(m_board, m_gridRows);
+							auto validMoves = getValidMoves(piece);
 							m_validMoveIndicators.clear();
 							
-							const float cellSizeXY = 100.0f;
+							const float cellSizeXY = getCellSize();
 							const float gridSizeXY = m_gridRows * cellSizeXY;
 							const float x0 = 0.5f * (static_cast<float>(ScreenSize::s_width) - gridSizeXY);
 							const float y0 = 0.5f * (static_cast<float>(ScreenSize::s_height) - gridSizeXY);
@@ -575,6 +745,7 @@ void Game::processGameEvents(const sf::Event& event)
 								});
 								m_validMoveIndicators.push_back(indicator);
 							}
+							m_boardDirty = true;
 						}
 						return;
 					}
@@ -595,10 +766,10 @@ void Game::processGameEvents(const sf::Event& event)
 						
 						// Show valid move previews if in movement phase and piece is on board
 						if (m_gamePhase == GamePhase::Movement && piece.getGridRow() >= 0) {
-							auto validMoves = piece.getValidMoves(m_board, m_gridRows);
+							auto validMoves = getValidMoves(piece);
 							m_validMoveIndicators.clear();
 							
-							const float cellSizeXY = 100.0f;
+							const float cellSizeXY = getCellSize();
 							const float gridSizeXY = m_gridRows * cellSizeXY;
 							const float x0 = 0.5f * (static_cast<float>(ScreenSize::s_width) - gridSizeXY);
 							const float y0 = 0.5f * (static_cast<float>(ScreenSize::s_height) - gridSizeXY);
@@ -615,6 +786,7 @@ void Game::processGameEvents(const sf::Event& event)
 								});
 								m_validMoveIndicators.push_back(indicator);
 							}
+							m_boardDirty = true;
 						}
 						return;
 					}
@@ -639,6 +811,7 @@ void Game::processGameEvents(const sf::Event& event)
 			m_selectedPiece = nullptr;
 			m_isDragging = false;
 			m_validMoveIndicators.clear();
+			m_boardDirty = true;
 		}
 	}
 
@@ -650,6 +823,11 @@ void Game::processGameEvents(const sf::Event& event)
 				Vector2i(mouseMoved->position.x, mouseMoved->position.y)
 			);
 			m_selectedPiece->setPosition(mousePos + m_dragOffset);
+			// Latency is measured from the oldest movement the next frame shows
+			if (!m_dragInputPending) {
+				m_dragInputPending = true;
+				m_dragInputTime = m_frameTimer.getElapsedTime();
+			}
 		}
 	}
 }
@@ -659,11 +837,31 @@ void Game::processGameEvents(const sf::Event& event)
 ////////////////////////////////////////////////////////////
 void Game::update(double dt)
 {
+	Trace::Zone zone("Game::update");
+
 	if (m_menu.getState() != Menu::State::Hidden) {
+		Trace::Zone menuZone("Menu::update");
 		auto mousePos = m_window.mapPixelToCoords(sf::Mouse::getPosition(m_window));
 		m_menu.update(mousePos);
 	}
 
+	if (m_isAIvsAI && m_menu.getState() == Menu::State::Hidden && m_gamePhase != GamePhase::GameOver) {
+		auto mousePos = m_window.mapPixelToCoords(sf::Mouse::getPosition(m_window));
+		m_turboSpeedButton.update(mousePos);
+		m_skipButton.update(mousePos);
+
+		// Above 1x the turbo thread plays the game; updates only show its latest move
+		if (m_turboSpeed != TurboSpeed::Normal || m_turboSkipping) {
+			const double normalInterval = m_aiDelayEnabled ? m_aiThinkDuration : 1000.0 / FPS;
+			m_turboMoveInterval = (m_turboSkipping || m_turboSpeed == TurboSpeed::Max) ? 0.0 : normalInterval / 10.0;
+			if (!m_turboThread.joinable()) {
+				startTurbo();
+			}
+			syncTurboFrame();
+			return;
+		}
+	}
+
 	// Handle AI vs AI mode - both players are AI
 	if (m_isAIvsAI && m_gamePhase == GamePhase::Placement && !m_aiThinking) {
 		m_aiThinking = true;
@@ -691,6 +889,7 @@ void Game::update(double dt)
 		if (m_aiThinkTime >= effectiveDelay) {
 			executeAIMove();
 			m_aiThinking = false;
+			m_sceneDirty = true;
 		}
 	}
 }
@@ -698,82 +897,160 @@ void Game::update(double dt)
 ////////////////////////////////////////////////////////////
 void Game::render()
 {
+	Trace::Zone zone("Game::render");
+	const sf::Time renderStart = m_frameTimer.getElapsedTime();
 	m_window.clear(sf::Color(0, 0, 0, 0));
 
-	for (const auto& cell : m_grid)
-		m_window.draw(cell);
-	for (const auto& cell : m_p1Grid)
-		m_window.draw(cell);
-	for (const auto& cell : m_p2Grid)
-		m_window.draw(cell);
-
-	// Draw valid move indicators
-	for (const auto& indicator : m_validMoveIndicators)
-		m_window.draw(indicator);
-
-	for (const auto& piece : m_p1Pieces)
-		piece.draw(m_window);
-	for (const auto& piece : m_p2Pieces)
-		piece.draw(m_window);
+	if (!m_sceneLayerReady) {
+		renderScene(m_window);
+		m_sceneDirty = false;
+	} else {
+		if (m_sceneDirty) {
+			renderScene(m_sceneLayer);
+			m_sceneLayer.display();
+			m_sceneDirty = false;
+		}
+		m_window.draw(sf::Sprite(m_sceneLayer.getTexture()));
+	}
 
-	if (m_gamePhase != GamePhase::GameOver) {
-		m_window.draw(m_statusText);
-		m_window.draw(m_instructionText);
+	// The dragged piece is the only thing that changes from frame to frame
+	if (m_isDragging && m_selectedPiece) {
+		m_window.draw(m_selectedPiece->getShape());
 	}
 #ifdef TEST_FPS
 	m_window.draw(x_updateFPS);
 	m_window.draw(x_drawFPS);
 #endif
+	if (m_showFrameStats) {
+		drawFrameStats();
+	}
+
+	const sf::Time presentStart = m_frameTimer.getElapsedTime();
+	{
+		Trace::Zone presentZone("present");
+		m_window.display();
+	}
+	const sf::Time frameEnd = m_frameTimer.getElapsedTime();
+
+	m_frameStats.record(FrameStats::Update, m_pendingUpdateTime.asMicroseconds() / 1000.0f);
+	m_frameStats.record(FrameStats::Render, (presentStart - renderStart).asMicroseconds() / 1000.0f);
+	m_frameStats.record(FrameStats::Present, (frameEnd - presentStart).asMicroseconds() / 1000.0f);
+	m_pendingUpdateTime = sf::Time::Zero;
+	if (m_dragInputPending) {
+		m_frameStats.record(FrameStats::InputLatency, (frameEnd - m_dragInputTime).asMicroseconds() / 1000.0f);
+		m_dragInputPending = false;
+	}
+}
+
+void Game::drawFrameStats()
+{
+	const FrameStats::Metric metrics[] = { FrameStats::Update, FrameStats::Render, FrameStats::Present, FrameStats::InputLatency };
+	const char* const names[] = { "Update", "Render", "Present", "Drag latency" };
+
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(2);
+	oss << "Frame times in ms, p50 / p95 / p99 (P to hide)\n";
+	for (int i = 0; i < 4; ++i) {
+		oss << names[i] << ": " << m_frameStats.percentile(metrics[i], 50.0f) << " / "
+			<< m_frameStats.percentile(metrics[i], 95.0f) << " / " << m_frameStats.percentile(metrics[i], 99.0f) << "\n";
+	}
+	m_frameStatsText.setString(oss.str());
+
+	// One bar per frame, newest on the right, scaled so two frame budgets fill the height
+	const float frameBudget = static_cast<float>(1000.0 / FPS);
+	const float graphWidth = m_frameStatsPanel.getSize().x - 20.0f;
+	const float graphHeight = 90.0f;
+	const float left = m_frameStatsPanel.getPosition().x + 10.0f;
+	const float bottom = m_frameStatsPanel.getPosition().y + m_frameStatsPanel.getSize().y - 10.0f;
+	const int bars = std::min(static_cast<int>(graphWidth), m_frameStats.sampleCount(FrameStats::Render));
+
+	m_frameGraph.clear();
+	for (int age = 0; age < bars; ++age) {
+		const float frameTime = m_frameStats.sample(FrameStats::Update, age) + m_frameStats.sample(FrameStats::Render, age)
+			+ m_frameStats.sample(FrameStats::Present, age);
+		const float height = std::min(frameTime / (2.0f * frameBudget), 1.0f) * graphHeight;
+		RenderBatch::appendQuad(m_frameGraph, sf::FloatRect({ left + graphWidth - 1.0f - age, bottom - height }, { 1.0f, height }),
+			frameTime <= frameBudget ? sf::Color(100, 220, 100) : sf::Color(230, 80, 80), sf::FloatRect());
+	}
+	RenderBatch::appendQuad(m_frameGraph, sf::FloatRect({ left, bottom - graphHeight * 0.5f }, { graphWidth, 1.0f }),
+		sf::Color(255, 255, 255, 160), sf::FloatRect());
+
+	m_window.draw(m_frameStatsPanel);
+	m_window.draw(m_frameStatsText);
+	m_window.draw(m_frameGraph);
+}
+
+void Game::renderScene(sf::RenderTarget& target)
+{
+	Trace::Zone zone("Game::renderScene");
+	target.clear(sf::Color(0, 0, 0, 0));
+
+	// Grid, trays and valid move indicators in one call, rebuilt only when they change
+	if (m_boardDirty) {
+		buildBoardVertices();
+	}
+	target.draw(m_boardVertices);
+
+	// Every piece but the dragged one in a single call with the atlas bound
+	m_pieceVertices.clear();
+	for (const auto& piece : m_p1Pieces) {
+		if (m_isDragging && &piece == m_selectedPiece) continue;
+		RenderBatch::appendShape(m_pieceVertices, piece.getShape(), m_pieceAtlas.getWhiteTexel());
+	}
+	for (const auto& piece : m_p2Pieces) {
+		if (m_isDragging && &piece == m_selectedPiece) continue;
+		RenderBatch::appendShape(m_pieceVertices, piece.getShape(), m_pieceAtlas.getWhiteTexel());
+	}
+	target.draw(m_pieceVertices, &m_pieceAtlas.getTexture());
+
+	if (m_gamePhase != GamePhase::GameOver) {
+		target.draw(m_statusText);
+		target.draw(m_instructionText);
+	}
+
+	if (m_isAIvsAI && m_gamePhase != GamePhase::GameOver && m_menu.getState() == Menu::State::Hidden) {
+		m_turboSpeedButton.draw(target);
+		m_skipButton.draw(target);
+	}
 
 	if (m_menu.getState() != Menu::State::Hidden) {
-		m_menu.render(m_window);
+		Trace::Zone menuZone("Menu::render");
+		m_menu.render(target);
 	}
 
 	if (m_showAIAnalyzer && m_isAIGame && m_menu.getState() == Menu::State::Hidden) {
 		if (m_aiHasMoved) {
-			m_window.draw(m_aiMoveFromIndicator);
-			m_window.draw(m_aiMoveToIndicator);
+			target.draw(m_aiMoveFromIndicator);
+			target.draw(m_aiMoveToIndicator);
 		}
 		
-		m_window.draw(m_aiAnalyzerPanel);
-		m_window.draw(m_aiAnalyzerTitle);
-		m_window.draw(m_aiMovesConsideredText);
-		m_window.draw(m_aiBestMoveText);
-		m_window.draw(m_aiScoreText);
-		m_window.draw(m_aiDepthText);
-		m_window.draw(m_aiTimeText);
+		target.draw(m_aiAnalyzerPanel);
+		target.draw(m_aiAnalyzerTitle);
+		target.draw(m_aiMovesConsideredText);
+		target.draw(m_aiBestMoveText);
+		target.draw(m_aiScoreText);
+		target.draw(m_aiDepthText);
+		target.draw(m_aiTimeText);
+		target.draw(m_aiSearchStatsText);
 	}
-
-	m_window.display();
 }
 #pragma region AI
 
 void Game::executeAIMove()
 {
+	Trace::Zone zone("Game::executeAIMove");
 	if (m_gamePhase == GamePhase::GameOver) return;
 
 	// Start timing the AI calculation
 	m_aiCalculationClock.restart();
 
-	int searchDepth = 3;
-	switch (m_difficulty) {
-		case Difficulty::Easy:
-			searchDepth = 2;
-			break;
-		case Difficulty::Medium:
-			searchDepth = 3;
-			break;
-		case Difficulty::Hard:
-			searchDepth = 3;
-			break;
-	}
+	int searchDepth = getSearchDepth();
 
 	// In AI vs AI mode, use random placement for variety during placement phase
 	bool useRandomPlacement = m_isAIvsAI && m_gamePhase == GamePhase::Placement;
 	
 	// Determine which pieces to use based on current player
 	vector<Piece>& currentPlayerPieces = m_isPlayer1Turn ? m_p1Pieces : m_p2Pieces;
-	vector<Piece>& opponentPieces = m_isPlayer1Turn ? m_p2Pieces : m_p1Pieces;
 
 	// Determine which strategy to use
 	Strategy currentStrategy = Strategy::Balanced;
@@ -788,65 +1065,178 @@ void Game::executeAIMove()
 	// Get the current player's last move (not the opponent's)
 	Move currentPlayerLastMove = m_isPlayer1Turn ? m_lastMoveP1 : m_lastMoveP2;
 
-	Move aiMove = m_ai.findBestMove(m_board, currentPlayerPieces, opponentPieces, m_gridRows, 
-		m_gamePhase == GamePhase::Placement, searchDepth, useRandomPlacement, currentPlayerLastMove, currentStrategy);
+	// The search works on a plain-data copy of the rules board, never on the rendered pieces
+	const uint64_t nodeBudget = getNodeBudget();
+	Move aiMove = nodeBudget > 0
+		? m_ai.findBestMoveWithinBudget(m_position, nodeBudget, useRandomPlacement, currentPlayerLastMove, currentStrategy,
+			m_positionHistory)
+		: m_ai.findBestMove(m_position, searchDepth, useRandomPlacement, currentPlayerLastMove, currentStrategy,
+			m_positionHistory);
+	m_ai.journalLastDecision();
 
 	// Record calculation time
-	m_lastAICalculationTime = m_aiCalculationClock.getElapsedTime().asMilliseconds();
+	AIDecision decision = readAIDecision(m_position, m_aiCalculationClock.getElapsedTime().asMilliseconds());
+	m_lastAICalculationTime = decision.calculationTime;
+	if (m_decisionLog.isOpen() && aiMove.pieceIndex >= 0) {
+		m_decisionLog.append(formatDecisionRecord(m_position, currentStrategy, aiMove, decision));
+	}
 
 	if (aiMove.pieceIndex >= 0 && aiMove.pieceIndex < currentPlayerPieces.size()) {
 		m_aiHasMoved = true;
-		
-		std::ostringstream oss;
-		oss << "Moves Considered: " << m_ai.getMovesConsidered();
-		m_aiMovesConsideredText.setString(oss.str());
-
-		oss.str("");
-		if (m_gamePhase == GamePhase::Placement) {
-			oss << "Best Move:\nPlace piece at (" 
-				<< aiMove.toRow << ", " << aiMove.toCol << ")";
-		} else {
-			oss << "Best Move:\nFrom (" << aiMove.fromRow << ", " << aiMove.fromCol 
-				<< ") to (" << aiMove.toRow << ", " << aiMove.toCol << ")";
-		}
-		m_aiBestMoveText.setString(oss.str());
+		showAIDecision(aiMove, decision);
+		applyAIMove(aiMove);
+	}
+}
 
-		oss.str("");
-		oss << "Evaluation Score: " << m_ai.getBestScore();
-		m_aiScoreText.setString(oss.str());
+Game::AIDecision Game::readAIDecision(const Position& position, float calculationTime) const
+{
+	AIDecision decision;
+	decision.movesConsidered = m_ai.getMovesConsidered();
+	decision.bestScore = m_ai.getBestScore();
+	decision.searchDepth = m_ai.getLastSearchDepth();
+	decision.fromBook = m_ai.wasLastMoveFromBook();
+	decision.cached = m_ai.wasLastMoveCached();
+	decision.nodeBudget = getNodeBudget();
+	decision.calculationTime = calculationTime;
+	decision.search = m_ai.getSearchStats();
+
+	// Replay the line so each move is written from the position it is played in
+	Match line(position, PositionHistory(), Move(), Move());
+	for (int i = 0; i < decision.search.principalVariationLength; ++i) {
+		const Move& move = decision.search.principalVariation[i];
+		const std::string text = MoveNotation::format(line.getPosition(), move);
+		if (!line.play(move)) break;
+		if (i > 0) decision.principalVariation += ' ';
+		decision.principalVariation += text;
+	}
 
-		oss.str("");
-		oss << "Search Depth: " << searchDepth << " levels";
-		m_aiDepthText.setString(oss.str());
+	// Root moves in search order; a stable sort keeps that order among equal scores
+	const Move selected = m_ai.getSelectedMove();
+	for (const RootMove& rootMove : m_ai.getRootMoves()) {
+		if (!sameMove(rootMove.move, selected)) decision.alternatives.push_back(rootMove);
+	}
+	std::stable_sort(decision.alternatives.begin(), decision.alternatives.end(),
+		[](const RootMove& a, const RootMove& b) { return a.score > b.score; });
+	if (decision.alternatives.size() > static_cast<size_t>(MAX_ALTERNATIVES)) decision.alternatives.resize(MAX_ALTERNATIVES);
+	return decision;
+}
 
-		oss.str("");
-		oss << "Calculation Time: " << std::fixed << std::setprecision(1) 
-			<< m_lastAICalculationTime << "ms";
-		m_aiTimeText.setString(oss.str());
+std::string Game::formatDecisionRecord(const Position& position, Strategy strategy, const Move& move, const AIDecision& decision) const
+{
+	const SearchStats& stats = decision.search;
+	const char* source = decision.fromBook ? "book" : decision.cached ? "cache" : "search";
+	const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(3)
+		<< "{\"time\":" << now
+		<< ",\"variant\":\"" << Variants::get(position.variant).name << "\""
+		<< ",\"board\":\"" << MoveNotation::formatBoard(position) << "\""
+		<< ",\"to_move\":" << (position.player1ToMove ? 1 : 2)
+		<< ",\"phase\":\"" << (position.placementPhase ? "placement" : "movement") << "\""
+		<< ",\"strategy\":\"" << STRATEGY_NAMES[static_cast<int>(strategy)] << "\""
+		<< ",\"difficulty\":\"" << DIFFICULTY_NAMES[static_cast<int>(m_difficulty)] << "\""
+		<< ",\"source\":\"" << source << "\""
+		<< ",\"depth\":" << decision.searchDepth
+		<< ",\"node_budget\":" << decision.nodeBudget
+		<< ",\"max_depth\":" << stats.maxDepthReached
+		<< ",\"nodes\":" << stats.nodes
+		<< ",\"leaf_evals\":" << stats.leafEvaluations
+		<< ",\"cutoffs\":" << stats.betaCutoffs;
+	if (AllocationTracker::ENABLED) {
+		oss << ",\"allocations\":" << stats.allocations
+			<< ",\"allocated_bytes\":" << stats.allocatedBytes
+			<< ",\"peak_bytes\":" << stats.peakAllocatedBytes;
+	}
+	oss << ",\"time_ms\":" << decision.calculationTime
+		<< ",\"search_ms\":" << stats.elapsedMs
+		<< ",\"score\":" << decision.bestScore
+		<< ",\"move\":\"" << MoveNotation::format(position, move) << "\""
+		<< ",\"pv\":\"" << decision.principalVariation << "\""
+		<< ",\"alternatives\":[";
+	for (size_t i = 0; i < decision.alternatives.size(); ++i) {
+		const RootMove& alternative = decision.alternatives[i];
+		oss << (i > 0 ? "," : "") << "{\"move\":\"" << MoveNotation::format(position, alternative.move)
+			<< "\",\"score\":" << alternative.score << ",\"exact\":" << (alternative.exact ? "true" : "false") << "}";
+	}
+	oss << "]}";
+	return oss.str();
+}
 
-		const float cellSizeXY = 100.0f;
-		const float gridSizeXY = m_gridRows * cellSizeXY;
-		const float x0 = 0.5f * (static_cast<float>(ScreenSize::s_width) - gridSizeXY);
-		const float y0 = 0.5f * (static_cast<float>(ScreenSize::s_height) - gridSizeXY);
+void Game::showAIDecision(const Move& move, const AIDecision& decision)
+{
+	std::ostringstream oss;
+	oss << "Moves Considered: " << decision.movesConsidered;
+	m_aiMovesConsideredText.setString(oss.str());
+
+	oss.str("");
+	if (move.fromRow < 0) {
+		oss << "Best Move:\nPlace piece at (" 
+			<< move.toRow << ", " << move.toCol << ")";
+	} else {
+		oss << "Best Move:\nFrom (" << move.fromRow << ", " << move.fromCol 
+			<< ") to (" << move.toRow << ", " << move.toCol << ")";
+	}
+	m_aiBestMoveText.setString(oss.str());
 
-		if (m_gamePhase == GamePhase::Movement && aiMove.fromRow >= 0 && aiMove.fromCol >= 0) {
-			Vector2f fromPos = {
-				x0 + static_cast<float>(aiMove.fromCol * cellSizeXY),
-				y0 + static_cast<float>(aiMove.fromRow * cellSizeXY)
-			};
-			m_aiMoveFromIndicator.setPosition(fromPos);
-		} else {
-			m_aiMoveFromIndicator.setPosition({ -1000.0f, -1000.0f });
-		}
+	oss.str("");
+	oss << "Evaluation Score: " << decision.bestScore;
+	m_aiScoreText.setString(oss.str());
 
-		Vector2f toPos = {
-			x0 + static_cast<float>(aiMove.toCol * cellSizeXY),
-			y0 + static_cast<float>(aiMove.toRow * cellSizeXY)
+	oss.str("");
+	if (decision.fromBook) {
+		oss << "Search Depth: opening book";
+	} else {
+		oss << "Search Depth: " << decision.searchDepth << " levels";
+		if (decision.cached) oss << " (cached)";
+		if (decision.nodeBudget > 0) oss << " (" << compactCount(decision.nodeBudget) << " node budget)";
+	}
+	m_aiDepthText.setString(oss.str());
+
+	oss.str("");
+	oss << "Calculation Time: " << std::fixed << std::setprecision(1) 
+		<< decision.calculationTime << "ms";
+	m_aiTimeText.setString(oss.str());
+
+	const SearchStats& stats = decision.search;
+	oss.str("");
+	oss << "Nodes: " << stats.nodes << " (" << stats.leafEvaluations << " leaf evals)\n"
+		<< "Cutoffs: " << stats.betaCutoffs << " (" << std::setprecision(0)
+		<< (stats.betaCutoffs > 0 ? 100.0 * stats.firstMoveCutoffs / stats.betaCutoffs : 0.0) << "% on first move)\n"
+		<< "Branching: " << std::setprecision(2) << stats.effectiveBranchingFactor
+		<< "   Nodes/sec: " << std::setprecision(0) << stats.nodesPerSecond
+		<< "   Max depth: " << stats.maxDepthReached << "\n"
+		<< "Nodes by ply:";
+	for (int ply = 1; ply <= stats.maxDepthReached && ply < SearchStats::MAX_PLY; ++ply) {
+		oss << ' ' << compactCount(stats.plyNodes[ply]);
+	}
+	if (AllocationTracker::ENABLED) {
+		oss << "\nAllocations: " << compactCount(stats.allocations) << " (" << std::setprecision(2)
+			<< stats.allocationsPerNode << " per node), peak " << compactCount(stats.peakAllocatedBytes) << "B";
+	}
+	oss << "\nPV: " << (decision.principalVariation.empty() ? std::string("-") : decision.principalVariation);
+	m_aiSearchStatsText.setString(oss.str());
+
+	const float cellSizeXY = getCellSize();
+	const float gridSizeXY = m_gridRows * cellSizeXY;
+	const float x0 = 0.5f * (static_cast<float>(ScreenSize::s_width) - gridSizeXY);
+	const float y0 = 0.5f * (static_cast<float>(ScreenSize::s_height) - gridSizeXY);
+
+	if (move.fromRow >= 0 && move.fromCol >= 0) {
+		Vector2f fromPos = {
+			x0 + static_cast<float>(move.fromCol * cellSizeXY),
+			y0 + static_cast<float>(move.fromRow * cellSizeXY)
 		};
-		m_aiMoveToIndicator.setPosition(toPos);
-
-		applyAIMove(aiMove);
+		m_aiMoveFromIndicator.setPosition(fromPos);
+	} else {
+		m_aiMoveFromIndicator.setPosition({ -1000.0f, -1000.0f });
 	}
+
+	Vector2f toPos = {
+		x0 + static_cast<float>(move.toCol * cellSizeXY),
+		y0 + static_cast<float>(move.toRow * cellSizeXY)
+	};
+	m_aiMoveToIndicator.setPosition(toPos);
 }
 
 void Game::applyAIMove(const Move& move)
@@ -856,7 +1246,7 @@ void Game::applyAIMove(const Move& move)
 
 	if (m_gamePhase == GamePhase::Placement) {
 		if (placePiece(piece, move.toRow, move.toCol)) {
-			const float cellSizeXY = 100.0f;
+			const float cellSizeXY = getCellSize();
 			const float gridSizeXY = m_gridRows * cellSizeXY;
 			const float x0 = 0.5f * (static_cast<float>(ScreenSize::s_width) - gridSizeXY);
 			const float y0 = 0.5f * (static_cast<float>(ScreenSize::s_height) - gridSizeXY);
@@ -876,7 +1266,7 @@ void Game::applyAIMove(const Move& move)
 		}
 	} else if (m_gamePhase == GamePhase::Movement) {
 		if (movePiece(piece, move.fromRow, move.fromCol, move.toRow, move.toCol)) {
-			const float cellSizeXY = 100.0f;
+			const float cellSizeXY = getCellSize();
 			const float gridSizeXY = m_gridRows * cellSizeXY;
 			const float x0 = 0.5f * (static_cast<float>(ScreenSize::s_width) - gridSizeXY);
 			const float y0 = 0.5f * (static_cast<float>(ScreenSize::s_height) - gridSizeXY);
@@ -886,7 +1276,6 @@ void Game::applyAIMove(const Move& move)
 			y0 + static_cast<float>(move.toRow * cellSizeXY)
 			};
 			piece->setPosition(cellPos);
-			updateBoard();
 			m_lastMove = move;
 			if (m_isPlayer1Turn) {
 				m_lastMoveP1 = move;
@@ -897,9 +1286,157 @@ void Game::applyAIMove(const Move& move)
 		}
 	}
 }
+
+void Game::setTurboSpeed(TurboSpeed speed)
+{
+	m_turboSpeed = speed;
+	m_turboSpeedButton.setText(std::string("Speed: ") + turboSpeedLabel(speed));
+	if (speed != TurboSpeed::Normal) return;
+
+	// Back to 1x: take over the game from the thread, and end it if the thread already had
+	stopTurbo(true);
+	syncTurboFrame();
+	if (m_gamePhase != GamePhase::GameOver) {
+		m_instructionText.setString("AI vs AI - Watch the game unfold!");
+	}
+}
+
+void Game::skipToResult()
+{
+	m_turboSkipping = true;
+	m_instructionText.setString("Skipping to the result...");
+}
+
+void Game::startTurbo()
+{
+	// The thread owns m_ai and its own copy of the game until it is joined
+	m_aiThinking = false;
+	m_turboMatch = Match(m_position, m_positionHistory, m_lastMoveP1, m_lastMoveP2, m_maxMoves);
+	m_turboFrame = TurboFrame();
+	m_turboFrameShown = 0;
+	m_turboQuit = false;
+	m_ai.setStopFlag(&m_turboQuit);
+	m_turboThread = std::thread(&Game::runTurbo, this, m_menu.getAI1Strategy(), m_menu.getAI2Strategy(), getSearchDepth(), getNodeBudget());
+}
+
+void Game::stopTurbo(bool adopt)
+{
+	if (!m_turboThread.joinable()) return;
+
+	// The stop flag also cuts short a search in progress, whose move is then dropped
+	m_turboQuit = true;
+	m_turboThread.join();
+	m_turboQuit = false;
+	m_ai.setStopFlag(nullptr);
+	m_turboSkipping = false;
+	if (!adopt) return;
+
+	showPosition(m_turboMatch.getPosition());
+	m_positionHistory = m_turboMatch.getHistory();
+	m_lastMoveP1 = m_turboMatch.getLastMove(0);
+	m_lastMoveP2 = m_turboMatch.getLastMove(1);
+}
+
+void Game::syncTurboFrame()
+{
+	TurboFrame frame;
+	{
+		std::lock_guard<std::mutex> lock(m_turboMutex);
+		if (m_turboFrame.serial == m_turboFrameShown) return;
+		// While skipping, the moves on the way to the result are never drawn
+		if (m_turboSkipping && m_turboFrame.result == Match::Result::InProgress) return;
+		frame = m_turboFrame;
+	}
+	m_turboFrameShown = frame.serial;
+	m_sceneDirty = true;
+
+	showPosition(frame.position);
+	m_lastMove = frame.move;
+	m_lastMoveP1 = frame.lastMoves[0];
+	m_lastMoveP2 = frame.lastMoves[1];
+	m_lastAICalculationTime = frame.decision.calculationTime;
+	if (frame.move.pieceIndex >= 0) {
+		m_aiHasMoved = true;
+		showAIDecision(frame.move, frame.decision);
+	}
+
+	if (frame.result == Match::Result::InProgress) {
+		const std::string phaseText = m_gamePhase == GamePhase::Placement ? "PLACEMENT" : "MOVEMENT";
+		m_statusText.setString(std::string(m_isPlayer1Turn ? "AI 1" : "AI 2") + " - " + phaseText + " PHASE");
+		m_instructionText.setString(std::string("AI vs AI - ") + turboSpeedLabel(m_turboSpeed) + " (move " + std::to_string(frame.movesPlayed) + ")");
+		return;
+	}
+
+	// The thread has finished with the game
+	stopTurbo(true);
+	if (frame.move.pieceIndex < 0) {
+		handleNoMove(frame.result == Match::Result::Player1Won);
+	} else if (frame.result == Match::Result::Draw) {
+		handleDraw(m_maxMoves > 0 && frame.movesPlayed >= m_maxMoves
+			? std::to_string(m_maxMoves) + " move limit reached" : "threefold repetition");
+	} else {
+		const int side = frame.result == Match::Result::Player1Won ? 0 : 1;
+		vector<Piece>& pieces = side == 0 ? m_p1Pieces : m_p2Pieces;
+		handleWinLogic(&pieces[frame.lastMoves[side].pieceIndex]);
+	}
+}
+
+void Game::runTurbo(Strategy player1Strategy, Strategy player2Strategy, int searchDepth, uint64_t nodeBudget)
+{
+	Trace::setThreadName("turbo");
+	while (!m_turboQuit && !m_turboMatch.isOver()) {
+		const auto moveStart = std::chrono::steady_clock::now();
+		const Position root = m_turboMatch.getPosition();
+		const int side = root.sideToMove();
+
+		// Random placement for variety, as executeAIMove does in AI vs AI games
+		sf::Clock clock;
+		const Strategy strategy = side == 0 ? player1Strategy : player2Strategy;
+		Move move = nodeBudget > 0
+			? m_ai.findBestMoveWithinBudget(root, nodeBudget, root.placementPhase, m_turboMatch.getLastMove(side), strategy,
+				m_turboMatch.getHistory())
+			: m_ai.findBestMove(root, searchDepth, root.placementPhase, m_turboMatch.getLastMove(side), strategy,
+				m_turboMatch.getHistory());
+		if (m_turboQuit) break;
+
+		// A side with no move, or whose move the match rejects, loses, as in the tournament
+		//  runner; the last frame still has to reach the window, or the game never ends there
+		const bool noMove = move.pieceIndex < 0 || !m_turboMatch.play(move);
+
+		TurboFrame frame;
+		frame.position = m_turboMatch.getPosition();
+		frame.move = noMove ? Move() : move;
+		frame.lastMoves[0] = m_turboMatch.getLastMove(0);
+		frame.lastMoves[1] = m_turboMatch.getLastMove(1);
+		frame.decision = readAIDecision(root, clock.getElapsedTime().asMilliseconds());
+		if (!noMove) {
+			m_ai.journalLastDecision();
+			if (m_decisionLog.isOpen()) m_decisionLog.append(formatDecisionRecord(root, strategy, move, frame.decision));
+		}
+		frame.result = noMove ? (side == 0 ? Match::Result::Player2Won : Match::Result::Player1Won) : m_turboMatch.getResult();
+		frame.movesPlayed = m_turboMatch.getMovesPlayed();
+		{
+			std::lock_guard<std::mutex> lock(m_turboMutex);
+			frame.serial = m_turboFrame.serial + 1;
+			m_turboFrame = frame;
+		}
+		if (noMove) break;
+
+		const double interval = m_turboMoveInterval;
+		if (interval > 0.0) {
+			std::this_thread::sleep_until(moveStart + std::chrono::duration<double, std::milli>(interval));
+		}
+	}
+}
 #pragma endregion
 
 #pragma region Helpers
+float Game::getCellSize() const
+{
+	// 100 px cells up to 9x9; larger boards share the same 900 px of height
+	return min(100.0f, 900.0f / static_cast<float>(m_gridRows));
+}
+
 void Game::setupGrid(vector<RectangleShape>& grid, int row, int col, int numCols, const float cellSizeXY, const float x0, const float y0, sf::Color outlineColour)
 {
 	grid[row * numCols + col].setSize(Vector2f(cellSizeXY, cellSizeXY));
@@ -912,6 +1449,20 @@ void Game::setupGrid(vector<RectangleShape>& grid, int row, int col, int numCols
 	));
 }
 
+void Game::buildBoardVertices()
+{
+	m_boardVertices.clear();
+	for (const auto& cell : m_grid)
+		RenderBatch::appendShape(m_boardVertices, cell);
+	for (const auto& cell : m_p1Grid)
+		RenderBatch::appendShape(m_boardVertices, cell);
+	for (const auto& cell : m_p2Grid)
+		RenderBatch::appendShape(m_boardVertices, cell);
+	for (const auto& indicator : m_validMoveIndicators)
+		RenderBatch::appendShape(m_boardVertices, indicator);
+	m_boardDirty = false;
+}
+
 void Game::snapToGrid(Vector2f mousePos)
 {
 	if (!m_selectedPiece) return;
@@ -940,7 +1491,6 @@ void Game::snapToGrid(Vector2f mousePos)
 						if (movePiece(m_selectedPiece, prevRow, prevCol, row, col)) {
 							Vector2f cellPos = cell.getPosition();
 							m_selectedPiece->setPosition(cellPos);
-							updateBoard();
 							foundValidCell = true;
 							endTurn();
 							return;
@@ -956,16 +1506,73 @@ void Game::snapToGrid(Vector2f mousePos)
 	}
 }
 
+int Game::getSearchDepth() const
+{
+	switch (m_difficulty) {
+		case Difficulty::Easy:
+			return 2;
+		case Difficulty::Medium:
+			return 3;
+		case Difficulty::Hard:
+			return 3;
+	}
+	return 3;
+}
+
+void Game::showPosition(const Position& position)
+{
+	m_board.reset(m_gridRows);
+	for (int side = 0; side < 2; ++side) {
+		vector<Piece>& pieces = side == 0 ? m_p1Pieces : m_p2Pieces;
+		const vector<RectangleShape>& homeGrid = side == 0 ? m_p1Grid : m_p2Grid;
+		for (int i = 0; i < static_cast<int>(pieces.size()); ++i) {
+			const int cell = position.pieceCells[side][i];
+			if (cell == Position::NONE) {
+				// Unplaced pieces wait in their owner's side grid, where setupPieces put them
+				pieces[i].setGridPosition(-1, -1);
+				pieces[i].setPosition(homeGrid[i].getPosition());
+				continue;
+			}
+			pieces[i].setGridPosition(cell / m_gridCols, cell % m_gridCols);
+			pieces[i].setPosition(m_grid[cell].getPosition());
+			m_board.cells[cell] = &pieces[i];
+		}
+	}
+
+	m_p1PiecesPlaced = position.placedCount[0];
+	m_p2PiecesPlaced = position.placedCount[1];
+	m_isPlayer1Turn = position.player1ToMove;
+	m_gamePhase = position.placementPhase ? GamePhase::Placement : GamePhase::Movement;
+	m_position = position;
+}
+
+uint64_t Game::getNodeBudget() const
+{
+	if (!m_useNodeBudgets) return 0;
+
+	// Near the worst case of the fixed depths on 5x5 (2 for Easy, 3 for Medium), with Hard a
+	// step up; unlike a depth, a budget costs the same on every board and machine
+	switch (m_difficulty) {
+		case Difficulty::Easy:
+			return 2000;
+		case Difficulty::Medium:
+			return 20000;
+		case Difficulty::Hard:
+			return 100000;
+	}
+	return 20000;
+}
+
 void Game::configureDifficulty()
 {
-	if (m_difficulty == Difficulty::Hard) {
-		m_gridRows = 7;
-		m_gridCols = 7;
+	if (m_forcedVariant >= 0) {
+		m_variant = m_forcedVariant;
 	}
 	else {
-		m_gridRows = 5;
-		m_gridCols = 5;
+		m_variant = Variants::findByGridSize(m_difficulty == Difficulty::Hard ? 7 : 5);
 	}
+	m_gridRows = Variants::get(m_variant).gridSize;
+	m_gridCols = m_gridRows;
 }
 
 #pragma endregion
@@ -18,10 +18,20 @@
 #endif // _DEBUG
 
 #include <SFML/Graphics.hpp>
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
+#include "DecisionLog.h"
+#include "FrameStats.h"
 #include "Piece.h"
+#include "PieceAtlas.h"
+#include "Trace.h"
 #include "AI.h"
+#include "Match.h"
+#include "Rules.h"
+#include "Variants.h"
 #include "Menu.h"
 
 using namespace std;
@@ -37,8 +47,8 @@ using namespace sf;
 /// <summary>
 /// @brief Main class for The Fourth Protocol game.
 /// 
-/// This implements a 5x5 grid-based game where players place pieces
-/// and move them to get 4 in a row.
+/// This implements a grid-based game (5x5 to 15x15, see Variants) where
+/// players place pieces and move them to get 4 (or 5) in a row.
 /// </summary>
 
 /// <summary>
@@ -56,6 +66,35 @@ public:
 	static const int s_height{ 1080 };
 };
 
+/// <summary>
+/// @brief Options read from the command line at launch.
+/// 
+/// Empty paths disable the corresponding feature.
+/// </summary>
+struct LaunchOptions
+{
+	/// @brief Analysis cache to memory-map and probe before AI searches (ignored if missing)
+	std::string analysisCachePath{ "ASSETS/CACHE/analysis.t4c" };
+	/// @brief Journal that new AI search results are appended to, for the cache_writer tool
+	std::string analysisJournalPath;
+	/// @brief Placement-phase opening book written by the book_builder tool (ignored if missing)
+	std::string openingBookPath{ "ASSETS/BOOK/opening.t4b" };
+	/// @brief Pre-decoded piece atlas written by the atlas_packer tool (the PNGs are packed at startup if missing)
+	std::string pieceAtlasPath{ "ASSETS/IMAGES/pieces.t4a" };
+	/// @brief Board variant to play (a Variants name such as "8x8-5"); empty picks it from the difficulty
+	std::string variant;
+	/// @brief Movement-phase moves after which the game is adjudicated a draw (0 for no limit)
+	int maxMoves{ 300 };
+	/// @brief CSV file the frame time histograms are written to on exit (empty to skip)
+	std::string frameStatsPath;
+	/// @brief Chrome trace file of the game loop and AI zones (empty to skip)
+	std::string tracePath;
+	/// @brief JSON-lines file every AI decision is appended to (empty to skip)
+	std::string decisionLogPath;
+	/// @brief Limit AI searches by the difficulty's node budget instead of its depth
+	bool nodeBudgets{ false };
+};
+
 class Game
 {
 public:
@@ -63,14 +102,27 @@ public:
 	enum class GamePhase {
 		Placement,		///< Players placing pieces on the board
 		Movement,		///< Players moving pieces already on the board  
-		GameOver		///< Game has finished with a winner
+		GameOver		///< Game has finished with a winner or a draw
+	};
+
+	/// @brief Playback speed of AI vs AI games
+	enum class TurboSpeed {
+		Normal,			///< One move per update, as the game has always played (1x)
+		Fast,			///< Moves simulated on a worker thread ten times as often (10x)
+		Max				///< Moves simulated on a worker thread as fast as the AI allows
 	};
 
 	/// <summary>
 	/// @brief Default constructor that initialises the SFML window, 
 	///   and sets vertical sync enabled. 
 	/// </summary>
-	Game();
+	/// <param name="options">Options read from the command line</param>
+	Game(const LaunchOptions& options = LaunchOptions());
+
+	/// <summary>
+	/// @brief Stops the turbo simulation thread if one is running.
+	/// </summary>
+	~Game();
 
 	/// <summary>
 	/// @brief the main game loop.
@@ -82,6 +134,8 @@ public:
 	/// The target is at least one update and one render cycle per game loop, but typically 
 	///  more render than update operations will be performed as we expect our game loop to
 	///  complete in less than the target time.
+	/// While the game is idle (see isIdle) the loop instead blocks until an event arrives,
+	///  runs a single update for it and renders only if the scene changed.
 	/// </summary>
 	void run();
 
@@ -101,9 +155,18 @@ protected:
 	/// <summary>
 	/// @brief Draws the background and foreground game objects in the SFML window.
 	/// The render window is always cleared to black before anything is drawn.
+	/// Everything but the dragged piece comes from the cached scene layer, which
+	/// is only redrawn after something marks it dirty.
 	/// </summary>
 	void render();
 
+	/// <summary>
+	/// @brief Draws the board, pieces (except the one being dragged), text,
+	///   menu and AI analyzer.
+	/// </summary>
+	/// <param name="target">Cached scene layer, or the window if the layer could not be created</param>
+	void renderScene(sf::RenderTarget& target);
+
 	/// <summary>
 	/// @brief Checks for events.
 	/// Allows window to function and exit. 
@@ -111,6 +174,20 @@ protected:
 	/// </summary>	
 	void processEvents();
 
+	/// <summary>
+	/// @brief Handles one event: closing the window, marking the scene dirty
+	///   and passing it on to Game::processGameEvents().
+	/// </summary>
+	/// <param name="event">system event</param>
+	void handleEvent(const sf::Event& event);
+
+	/// <summary>
+	/// @brief Checks if nothing can change without input: no drag, no AI
+	///   thinking or due to move, and no AI vs AI playback.
+	/// </summary>
+	/// <returns>True if the loop may block waiting for events</returns>
+	bool isIdle() const;
+
 	/// <summary>
 	/// @brief Handles all user input.
 	/// </summary>
@@ -137,6 +214,10 @@ protected:
 #pragma endregion
 
 private:
+	/// @brief Get the on-screen size of a board cell, shrunk so large variants still fit the window
+	/// @return Cell size in pixels
+	float getCellSize() const;
+
 	/// @brief Sets up a grid of RectangleShapes for the game board
 	/// @param grid Vector of RectangleShape objects to populate
 	/// @param row Starting row position for the grid
@@ -150,12 +231,18 @@ private:
 	
 	/// @brief Sets up pieces for a player at game start
 	/// @param pieces Vector of Piece objects to initialize
-	/// @param row Starting row for piece placement
+	/// @param row Starting row for piece placement (also the piece's index in the variant's set)
 	/// @param cellSizeXY Size of each cell for piece sizing
 	/// @param startPos Starting position for piece placement
 	/// @param isP1 True if setting up Player 1 pieces, false for Player 2
 	void setupPieces(vector<Piece>& pieces, int row, const float cellSizeXY, Vector2f startPos, bool isP1);
 
+	/// @brief Rebuild m_boardVertices from the grid, trays and move indicators
+	void buildBoardVertices();
+
+	/// @brief Draw the performance overlay: recent percentiles and a frame time graph
+	void drawFrameStats();
+
 	/// @brief Snaps a piece position to the nearest valid grid location
 	/// @param mousePos Current mouse position to snap to grid
 	void snapToGrid(Vector2f mousePos);
@@ -178,6 +265,14 @@ private:
 	/// @param piece Pointer to the Piece object that caused the win condition.
     void handleWinLogic(Piece *piece);
 
+	/// @brief Ends the game without a winner
+	/// @param reason Why the game was drawn, shown on the game over screen
+	void handleDraw(const std::string& reason);
+
+	/// @brief Ends the game because the side to move had no legal move, which loses as in the tournament runner
+	/// @param player1Won True if Player 1 won because Player 2 could not move
+	void handleNoMove(bool player1Won);
+
     /// @brief Moves a piece from one grid position to another
 	/// @param piece Pointer to the piece to move
 	/// @param fromRow Source grid row
@@ -190,19 +285,21 @@ private:
 	/// @brief Ends the current player's turn and switches to the other player
 	void endTurn();
 	
-	/// @brief Checks if the specified player has achieved a win condition (4 in a row)
-	/// @param isPlayer1 True to check Player 1's win condition, false for Player 2
-	/// @return True if player has won, false otherwise
-	bool checkWinCondition(bool isPlayer1);
-	
 	/// @brief Gets a pointer to the piece at the specified grid position
 	/// @param row Grid row to check
 	/// @param col Grid column to check
 	/// @return Pointer to piece at position, or nullptr if empty
 	Piece* getPieceAtGridPosition(int row, int col);
 	
-	/// @brief Updates the internal board state representation
-	void updateBoard();
+	/// @brief Get the index of a piece in its owner's piece vector (its index in m_position)
+	/// @param piece Piece owned by either player
+	/// @return Piece index
+	int getPieceIndex(const Piece* piece) const;
+
+	/// @brief List the cells a placed piece can move to under the shared rules
+	/// @param piece Piece on the board
+	/// @return (row, col) of every legal target, in row-major order
+	vector<pair<int, int>> getValidMoves(const Piece& piece) const;
 
 	// AI methods
 	/// @brief Executes an AI move during the AI player's turn
@@ -212,12 +309,94 @@ private:
 	/// @param move The Move object containing move details to apply
 	void applyAIMove(const Move& move);
 
-	/// @brief Configure grid size and pieces based on difficulty
+	/// @brief Figures the AI analyzer shows for one decision
+	struct AIDecision {
+		int movesConsidered = 0;		///< Moves the search considered
+		int bestScore = 0;				///< Evaluation score of the chosen move
+		int searchDepth = 0;			///< Depth the move was searched to
+		bool fromBook = false;			///< True if the move came from the opening book
+		bool cached = false;			///< True if the move came from the analysis cache
+		uint64_t nodeBudget = 0;		///< Node budget of the search (0 if limited by depth)
+		float calculationTime = 0.0f;	///< Time taken in milliseconds
+		SearchStats search;				///< Search telemetry
+		std::string principalVariation;	///< Principal variation in move notation
+		std::vector<RootMove> alternatives;	///< Best-scored other root moves, best first
+	};
+
+	/// @brief Latest state published by the turbo thread, shown by the next update
+	struct TurboFrame {
+		Position position = {};			///< Position after the move
+		Move move;						///< Move just played (pieceIndex -1 if the side to move had none and lost)
+		Move lastMoves[2];				///< Last move of each side
+		AIDecision decision;			///< How the AI chose the move
+		Match::Result result = Match::Result::InProgress;	///< State of the game after the move
+		int movesPlayed = 0;			///< Movement-phase moves played
+		unsigned serial = 0;			///< Incremented for every move, 0 before the first
+	};
+
+	/// @brief Read the figures of the AI's last decision
+	/// @param position Position the AI searched
+	/// @param calculationTime Time the search took in milliseconds
+	/// @return Figures for the AI analyzer
+	AIDecision readAIDecision(const Position& position, float calculationTime) const;
+
+	/// @brief Write an AI decision as one JSON line for the decision log
+	/// @param position Position the AI searched
+	/// @param strategy Strategy the AI played with
+	/// @param move Move the AI chose
+	/// @param decision Figures of the decision
+	/// @return Record without the trailing newline
+	std::string formatDecisionRecord(const Position& position, Strategy strategy, const Move& move, const AIDecision& decision) const;
+
+	/// @brief Show an AI decision in the analyzer panel and the move indicators
+	/// @param move Move the AI chose
+	/// @param decision Figures for the analyzer
+	void showAIDecision(const Move& move, const AIDecision& decision);
+
+	/// @brief Lay out the rendered pieces and the board to match a position
+	/// @param position Position to show, which also becomes m_position
+	void showPosition(const Position& position);
+
+	/// @brief Change the AI vs AI playback speed, starting or stopping the turbo thread
+	/// @param speed New speed
+	void setTurboSpeed(TurboSpeed speed);
+
+	/// @brief Play the rest of the AI vs AI game at full speed and show only the result
+	void skipToResult();
+
+	/// @brief Start simulating the AI vs AI game on the turbo thread from the current state
+	void startTurbo();
+
+	/// @brief Stop the turbo thread
+	/// @param adopt True to continue the game at 1x from where the thread left it
+	void stopTurbo(bool adopt);
+
+	/// @brief Show the turbo thread's latest frame, ending the game once its result is in
+	void syncTurboFrame();
+
+	/// @brief Body of the turbo thread: play AI moves until the game ends or it is stopped
+	/// @param player1Strategy Strategy of AI 1
+	/// @param player2Strategy Strategy of AI 2
+	/// @param searchDepth Search depth for the difficulty
+	/// @param nodeBudget Node budget for the difficulty (0 to search to searchDepth)
+	void runTurbo(Strategy player1Strategy, Strategy player2Strategy, int searchDepth, uint64_t nodeBudget);
+
+	/// @brief Get the search depth for the current difficulty
+	/// @return Plies to search
+	int getSearchDepth() const;
+
+	/// @brief Get the search nodes the AI may spend per move at the current difficulty
+	/// @return Node budget, or 0 if searches are limited by depth
+	uint64_t getNodeBudget() const;
+
+	/// @brief Configure the variant (grid size and pieces) based on difficulty or the launch options
 	void configureDifficulty();
 
 	// Board state
-	/// @brief 2D vector representing the game board state with piece pointers
-	vector<vector<Piece*>> m_board;
+	/// @brief Row-major board of piece pointers, laid out like the search's Position
+	GameBoard m_board;
+	/// @brief Rules view of the same board, updated in place by every move and handed to the AI
+	Position m_position = {};
 
 	/// @brief Grid rectangles for the main game board visualization
 	vector<RectangleShape> m_grid;
@@ -231,16 +410,21 @@ private:
 	/// @brief Grid rectangles for Player 2's piece area
 	vector<RectangleShape> m_p2Grid;
 
-	/// @brief Texture for frog pieces
-	Texture m_frogTexture{ "ASSETS/IMAGES/frog.png" };
-	/// @brief Texture for snake pieces
-	Texture m_snakeTexture{ "ASSETS/IMAGES/snake.png" };
-	/// @brief Texture for donkey pieces
-	Texture m_donkeyTexture{ "ASSETS/IMAGES/donkey.png" };
-	/// @brief Texture for antelope pieces
-	Texture m_antelopeTexture{ "ASSETS/IMAGES/antelope.png" };
-	/// @brief Texture for lion pieces
-	Texture m_lionTexture{ "ASSETS/IMAGES/lion.png" };
+	/// @brief Every piece type's image in one texture, so all pieces draw in one batch
+	PieceAtlas m_pieceAtlas;
+
+	/// @brief Board grid, side trays and move indicators as one triangle array
+	VertexArray m_boardVertices{ PrimitiveType::Triangles };
+	/// @brief True when the grid, trays or indicators changed since m_boardVertices was built
+	bool m_boardDirty = true;
+	/// @brief Every piece as one triangle array drawn with the atlas, rebuilt with the scene layer
+	VertexArray m_pieceVertices{ PrimitiveType::Triangles };
+	/// @brief Window-sized layer holding the last rendered scene
+	RenderTexture m_sceneLayer;
+	/// @brief True once m_sceneLayer was created; otherwise the scene is drawn straight to the window
+	bool m_sceneLayerReady = false;
+	/// @brief True when anything but the dragged piece changed since m_sceneLayer was drawn
+	bool m_sceneDirty = true;
 
 	/// @brief Collection of Player 1's pieces
 	vector<Piece> m_p1Pieces;
@@ -266,8 +450,14 @@ private:
 	int m_p1PiecesPlaced = 0;
 	/// @brief Number of pieces Player 2 has placed on the board
 	int m_p2PiecesPlaced = 0;
-	/// @brief Pointer to the winning piece (nullptr if no winner yet)
+	/// @brief Pointer to the winning piece (nullptr if no winner yet, or the game was drawn)
 	Piece* m_winner = nullptr;
+	/// @brief Movement-phase positions reached so far, for threefold repetition
+	PositionHistory m_positionHistory;
+	/// @brief Movement-phase moves after which the game is drawn (0 for no limit)
+	int m_maxMoves = 0;
+	/// @brief True if AI searches are limited by node budgets instead of depth
+	bool m_useNodeBudgets = false;
 
 	/// @brief Text object displaying current game status
 	sf::Text m_statusText{ m_arialFont };
@@ -289,6 +479,8 @@ private:
 	sf::Text m_aiDepthText{ m_arialFont };
 	/// @brief Text showing time taken to calculate
 	sf::Text m_aiTimeText{ m_arialFont };
+	/// @brief Text showing the search telemetry and principal variation
+	sf::Text m_aiSearchStatsText{ m_arialFont };
 	/// @brief Visual indicator for AI's last move (from position)
 	sf::RectangleShape m_aiMoveFromIndicator;
 	/// @brief Visual indicator for AI's last move (to position)
@@ -307,6 +499,10 @@ private:
 	Menu m_menu;
 	/// @brief Current difficulty level for AI opponent
 	Difficulty m_difficulty = Difficulty::Medium;
+	/// @brief Index of the variant being played in the Variants table
+	int m_variant = 0;
+	/// @brief Variant forced by the launch options (-1 to pick it from the difficulty)
+	int m_forcedVariant = -1;
 
 	// AI
 	/// @brief AI player instance for computer opponent
@@ -329,5 +525,54 @@ private:
 	Move m_lastMoveP1;
 	/// @brief Last move made by player 2
 	Move m_lastMoveP2;
+
+	// Turbo mode (AI vs AI)
+	/// @brief Selected AI vs AI playback speed
+	TurboSpeed m_turboSpeed = TurboSpeed::Normal;
+	/// @brief True while the rest of the game is being played without showing the moves
+	bool m_turboSkipping = false;
+	/// @brief Thread simulating the game at 10x or max speed (not joinable at 1x)
+	std::thread m_turboThread;
+	/// @brief Game the turbo thread plays, owned by it until it is joined
+	Match m_turboMatch;
+	/// @brief Set to make the turbo thread stop, also the AI's search stop flag
+	std::atomic<bool> m_turboQuit{ false };
+	/// @brief Least time between turbo moves in milliseconds (0 for no pacing)
+	std::atomic<double> m_turboMoveInterval{ 0.0 };
+	/// @brief Guards m_turboFrame
+	std::mutex m_turboMutex;
+	/// @brief Latest state published by the turbo thread
+	TurboFrame m_turboFrame;
+	/// @brief Serial of the last turbo frame shown
+	unsigned m_turboFrameShown = 0;
+	/// @brief Button cycling the playback speed through 1x, 10x and max
+	MenuButton m_turboSpeedButton{ { 20.0f, static_cast<float>(ScreenSize::s_height) - 80.0f }, { 220.0f, 55.0f }, "Speed: 1x", m_arialFont };
+	// Performance overlay
+	/// @brief Update, render, present and drag latency times of rendered frames
+	FrameStats m_frameStats;
+	/// @brief Flag to show/hide the performance overlay
+	bool m_showFrameStats = false;
+	/// @brief File the histograms are written to when the game loop ends (empty to skip)
+	std::string m_frameStatsPath;
+	/// @brief Free-running clock that frame and input times are taken from
+	sf::Clock m_frameTimer;
+	/// @brief Time spent in updates since the last rendered frame
+	sf::Time m_pendingUpdateTime = sf::Time::Zero;
+	/// @brief True when a drag movement has been handled but not yet displayed
+	bool m_dragInputPending = false;
+	/// @brief When the first drag movement not yet displayed was handled
+	sf::Time m_dragInputTime = sf::Time::Zero;
+	/// @brief Background panel for the performance overlay
+	sf::RectangleShape m_frameStatsPanel;
+	/// @brief Percentile table of the performance overlay
+	sf::Text m_frameStatsText{ m_arialFont };
+	/// @brief Bars of the frame time graph
+	VertexArray m_frameGraph{ PrimitiveType::Triangles };
+
+	/// @brief Button playing the rest of the game without showing it
+	MenuButton m_skipButton{ { 260.0f, static_cast<float>(ScreenSize::s_height) - 80.0f }, { 260.0f, 55.0f }, "Skip to result", m_arialFont };
+
+	/// @brief JSON-lines log every AI decision is appended to (closed = disabled)
+	DecisionLog m_decisionLog;
 };
 
@@ -0,0 +1,61 @@
+/**
+ * @file GameBoard.h
+ * @brief Flat board storage for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the GameBoard struct, the board Game keeps of its
+ * rendered pieces. It is one fixed-size row-major array of cells addressed
+ * by a single index (row * gridSize + col), the same layout Position uses
+ * for the search, so no per-row allocations or pointer chasing are needed.
+ */
+
+#pragma once
+
+class Piece;
+
+/// @brief Contiguous row-major board of piece pointers with a fixed maximum size
+struct GameBoard {
+	/// @brief Largest supported grid size
+	static const int MAX_GRID_SIZE = 15;
+	/// @brief Largest number of cells on the board
+	static const int MAX_CELLS = MAX_GRID_SIZE * MAX_GRID_SIZE;
+
+	/// @brief Size of the game grid
+	int gridSize = 0;
+	/// @brief Piece on every cell (nullptr if empty)
+	Piece* cells[MAX_CELLS] = {};
+
+	/// @brief Empty the board and set its size
+	/// @param size Size of the game grid (at most MAX_GRID_SIZE)
+	void reset(int size)
+	{
+		gridSize = size;
+		for (auto& cell : cells) cell = nullptr;
+	}
+
+	/// @brief Get the single index of a cell
+	/// @param row Grid row
+	/// @param col Grid column
+	/// @return Row-major cell index
+	int index(int row, int col) const { return row * gridSize + col; }
+
+	/// @brief Check if a cell is on the board
+	/// @param row Grid row
+	/// @param col Grid column
+	/// @return True if the cell is inside the grid
+	bool contains(int row, int col) const { return row >= 0 && row < gridSize && col >= 0 && col < gridSize; }
+
+	/// @brief Get the piece on a cell
+	/// @param row Grid row (must be on the board)
+	/// @param col Grid column (must be on the board)
+	/// @return Piece on the cell, or nullptr if empty
+	Piece* at(int row, int col) const { return cells[row * gridSize + col]; }
+
+	/// @brief Get a writable reference to a cell
+	/// @param row Grid row (must be on the board)
+	/// @param col Grid column (must be on the board)
+	/// @return Reference to the cell's piece pointer
+	Piece*& at(int row, int col) { return cells[row * gridSize + col]; }
+};
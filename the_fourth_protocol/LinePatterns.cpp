@@ -0,0 +1,53 @@
+#include "LinePatterns.h"
+
+LinePatterns::LinePatterns(const EvalWeights& weights)
+{
+	const int multipliers[DIRECTION_COUNT] = { weights.horizontal, weights.vertical, weights.diagonal };
+
+	for (int direction = 0; direction < DIRECTION_COUNT; ++direction) {
+		const int multiplier = multipliers[direction];
+		m_scores[direction].assign(PATTERN_COUNT, 0);
+
+		for (int code = 0; code < PATTERN_COUNT; ++code) {
+			int digits[MAX_LINE_LENGTH];
+			for (int i = 0, rest = code; i < MAX_LINE_LENGTH; ++i, rest /= 3) {
+				digits[i] = rest % 3;
+			}
+
+			m_scores[direction][code] = scoreLine(digits, MAX_LINE_LENGTH, multiplier, weights);
+		}
+	}
+}
+
+int LinePatterns::scoreLine(const int* digits, int length, int multiplier, const EvalWeights& weights)
+{
+	// Every piece in a run of length n scores n*n (boosted from 3 up), so the run scores n times that
+	int score = 0;
+	for (int start = 0; start < length; ) {
+		int owner = digits[start];
+		int end = start + 1;
+		while (end < length && digits[end] == owner) ++end;
+		int n = end - start;
+
+		if (owner == PLAYER2) {
+			int perPiece = (n >= 3)
+				? n * n * multiplier * 15 / 10 * weights.offense
+				: n * n * multiplier * weights.offense;
+			score += n * perPiece;
+		}
+		else if (owner == PLAYER1) {
+			int perPiece = (n >= 3)
+				? n * n * multiplier * 2 * weights.defense
+				: n * n * multiplier * weights.defense;
+			score -= n * perPiece;
+		}
+		start = end;
+	}
+	return score;
+}
+
+int LinePatterns::power(int index)
+{
+	static const int powers[MAX_LINE_LENGTH] = { 1, 3, 9, 27, 81, 243, 729, 2187 };
+	return powers[index];
+}
@@ -0,0 +1,85 @@
+/**
+ * @file LinePatterns.h
+ * @brief Line-pattern score tables for AI board evaluation
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the LinePatterns class. Every row, column and diagonal
+ * of the board is encoded as a base-3 number (one digit per cell: 0 empty,
+ * 1 Player 1, 2 Player 2), and the score contribution of every possible
+ * line is precomputed once, so a leaf evaluation is one table lookup per
+ * line instead of walking the board piece by piece.
+ */
+
+#pragma once
+#include <vector>
+
+/// @brief Evaluation multipliers of one strategy in one game phase
+struct EvalWeights {
+	/// @brief Multiplier for the closeness-to-centre score of each piece
+	int center;
+	/// @brief Multiplier for the bonus of pieces on the board edge
+	int edge;
+	/// @brief Multiplier for horizontal lines
+	int horizontal;
+	/// @brief Multiplier for vertical lines
+	int vertical;
+	/// @brief Multiplier for diagonal lines (both directions)
+	int diagonal;
+	/// @brief Multiplier applied to Player 2's (the AI's) lines
+	int offense;
+	/// @brief Multiplier applied to Player 1's (the opponent's) lines
+	int defense;
+};
+
+/// @brief Precomputed score of every line pattern for one set of weights
+class LinePatterns
+{
+public:
+	/// @brief Line orientations, which can be weighted differently
+	enum Direction {
+		Horizontal,		///< A board row
+		Vertical,		///< A board column
+		Diagonal,		///< A diagonal in either direction
+		DIRECTION_COUNT
+	};
+
+	/// @brief Longest line that can be encoded (the 8x8 board)
+	static const int MAX_LINE_LENGTH = 8;
+	/// @brief Number of distinct patterns of MAX_LINE_LENGTH cells (3^8)
+	static const int PATTERN_COUNT = 6561;
+	/// @brief Base-3 digit of an empty cell
+	static const int EMPTY = 0;
+	/// @brief Base-3 digit of a Player 1 cell
+	static const int PLAYER1 = 1;
+	/// @brief Base-3 digit of a Player 2 cell
+	static const int PLAYER2 = 2;
+
+	/// @brief Build the tables for a set of weights
+	/// @param weights Multipliers of the strategy (phase-dependent members are ignored)
+	explicit LinePatterns(const EvalWeights& weights);
+
+	/// @brief Get the score of a line
+	/// @param direction Orientation of the line
+	/// @param code Base-3 code of the line (first cell is the least significant digit)
+	/// @return Score from Player 2's point of view
+	int score(Direction direction, int code) const { return m_scores[direction][code]; }
+
+	/// @brief Score a line directly from its cells (used for lines too long to tabulate)
+	/// @param digits Base-3 digit of every cell along the line
+	/// @param length Number of cells
+	/// @param multiplier Line multiplier of the line's direction
+	/// @param weights Multipliers of the strategy
+	/// @return Score from Player 2's point of view
+	static int scoreLine(const int* digits, int length, int multiplier, const EvalWeights& weights);
+
+	/// @brief Get the power of three for a position along a line
+	/// @param index Position along the line, from 0
+	/// @return 3^index
+	static int power(int index);
+
+private:
+	/// @brief Score of every pattern for every direction
+	std::vector<int> m_scores[DIRECTION_COUNT];
+};
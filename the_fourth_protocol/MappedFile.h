@@ -0,0 +1,73 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory-mapped file wrapper for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the MappedFile class which maps a whole file into
+ * memory read-only, so large data files cost nothing to "load" and can be
+ * shared between several running processes by the operating system.
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+/// @brief Read-only view of a file mapped into the process address space
+///
+/// The mapping is released when the object is closed or destroyed. Objects
+/// can be moved but not copied, since each owns its operating system handles.
+class MappedFile
+{
+public:
+	/// @brief Default constructor creating an empty (closed) mapping
+	MappedFile() = default;
+
+	/// @brief Destructor unmapping the file if it is still open
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/// @brief Move constructor taking over another mapping
+	/// @param other Mapping to take over (left closed)
+	MappedFile(MappedFile&& other) noexcept;
+
+	/// @brief Move assignment taking over another mapping
+	/// @param other Mapping to take over (left closed)
+	/// @return Reference to this mapping
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	/// @brief Map a file read-only, closing any previous mapping first
+	/// @param path Path of the file to map
+	/// @return True if the file was opened and mapped, false otherwise
+	bool open(const std::string& path);
+
+	/// @brief Unmap the file and release all handles
+	void close();
+
+	/// @brief Check if a file is currently mapped
+	/// @return True if data() points at a valid mapping
+	bool isOpen() const { return m_data != nullptr; }
+
+	/// @brief Get the start of the mapped bytes
+	/// @return Pointer to the first byte, or nullptr if closed
+	const unsigned char* data() const { return m_data; }
+
+	/// @brief Get the size of the mapped file
+	/// @return Size in bytes (0 if closed)
+	std::size_t size() const { return m_size; }
+
+private:
+	/// @brief Start of the mapped view
+	const unsigned char* m_data = nullptr;
+	/// @brief Size of the mapped view in bytes
+	std::size_t m_size = 0;
+#ifdef _WIN32
+	/// @brief Win32 file handle
+	void* m_file = nullptr;
+	/// @brief Win32 file mapping handle
+	void* m_mapping = nullptr;
+#endif
+};
@@ -0,0 +1,51 @@
+#include "Match.h"
+#include "Rules.h"
+
+Match::Match(int variant, int maxMoves)
+	: m_position(Position::start(variant)), m_maxMoves(maxMoves)
+{
+}
+
+Match::Match(const Position& position, const PositionHistory& history, const Move& player1LastMove, const Move& player2LastMove, int maxMoves)
+	: m_position(position), m_history(history), m_lastMoves{ player1LastMove, player2LastMove }, m_maxMoves(maxMoves)
+{
+}
+
+bool Match::play(const Move& move)
+{
+	if (isOver() || move.pieceIndex < 0 || move.pieceIndex >= m_position.pieceCount[m_position.sideToMove()]) return false;
+
+	const int side = m_position.sideToMove();
+	const int cell = move.toRow * m_position.gridSize + move.toCol;
+	if (move.toRow < 0 || move.toRow >= m_position.gridSize || move.toCol < 0 || move.toCol >= m_position.gridSize) return false;
+
+	// A movement must start where the piece actually is
+	if (!m_position.placementPhase && m_position.pieceCells[side][move.pieceIndex] != move.fromRow * m_position.gridSize + move.fromCol) return false;
+
+	Rules::Outcome outcome = m_position.placementPhase
+		? Rules::placePiece(m_position, side, move.pieceIndex, cell)
+		: Rules::movePiece(m_position, side, move.pieceIndex, cell);
+	if (outcome == Rules::Outcome::Illegal) return false;
+
+	m_lastMoves[side] = move;
+	if (outcome == Rules::Outcome::Won) {
+		m_result = side == 0 ? Result::Player1Won : Result::Player2Won;
+		return true;
+	}
+	m_position.player1ToMove = !m_position.player1ToMove;
+
+	// Player 1 moves first once every piece is on the board, as in Game::endTurn
+	const int pieceCount = m_position.pieceCount[0];
+	if (m_position.placementPhase && m_position.placedCount[0] == pieceCount && m_position.placedCount[1] == pieceCount) {
+		m_position.placementPhase = false;
+		m_position.player1ToMove = true;
+	}
+	if (!m_position.placementPhase) {
+		const uint64_t key = m_position.repetitionKey();
+		m_history.push(key);
+		if (m_history.isRepetitionDraw(key) || (m_maxMoves > 0 && getMovesPlayed() >= m_maxMoves)) {
+			m_result = Result::Draw;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file Match.h
+ * @brief Headless game record for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the Match class, one game played without a window:
+ * the Position, the repetition history, each side's last move and the
+ * result. It follows the same turn order as Game (Player 1 moves first once
+ * every piece is placed) and the same draw rules (threefold repetition and
+ * an optional move limit), so the tournament runner, the engine and the
+ * game server all referee games exactly as the window does.
+ */
+
+#pragma once
+#include "AI.h"
+#include "Position.h"
+#include "PositionHistory.h"
+
+/// @brief One game played through the shared rules, without rendering
+class Match
+{
+public:
+	/// @brief State of the game
+	enum class Result {
+		InProgress,		///< The game goes on
+		Player1Won,		///< Player 1 completed a line
+		Player2Won,		///< Player 2 completed a line
+		Draw			///< Threefold repetition or the move limit
+	};
+
+	/// @brief Start a game from the empty board
+	/// @param variant Index of the variant in the Variants table
+	/// @param maxMoves Movement-phase moves after which the game is drawn (0 for no limit)
+	explicit Match(int variant = 0, int maxMoves = 0);
+
+	/// @brief Continue a game already in progress
+	/// @param position Current position with the side to move set
+	/// @param history Movement-phase positions reached so far, including the current one
+	/// @param player1LastMove Last move Player 1 played
+	/// @param player2LastMove Last move Player 2 played
+	/// @param maxMoves Movement-phase moves after which the game is drawn (0 for no limit)
+	Match(const Position& position, const PositionHistory& history, const Move& player1LastMove, const Move& player2LastMove, int maxMoves = 0);
+
+	/// @brief Play a move for the side to move
+	/// @param move Move with the piece index into the mover's pieces (fromRow < 0 for a placement)
+	/// @return False if the game is over or the move is illegal (nothing changes)
+	bool play(const Move& move);
+
+	/// @brief Get the current position
+	/// @return Position with the side to move set
+	const Position& getPosition() const { return m_position; }
+
+	/// @brief Get the movement-phase positions reached so far, including the current one
+	/// @return History to hand to AI::findBestMove
+	const PositionHistory& getHistory() const { return m_history; }
+
+	/// @brief Get the last move a side played
+	/// @param side 0 for Player 1, 1 for Player 2
+	/// @return Last move (pieceIndex -1 if the side has not moved)
+	const Move& getLastMove(int side) const { return m_lastMoves[side]; }
+
+	/// @brief Get the state of the game
+	/// @return Result so far
+	Result getResult() const { return m_result; }
+
+	/// @brief Check if the game has ended
+	/// @return True once someone has won or the game was drawn
+	bool isOver() const { return m_result != Result::InProgress; }
+
+	/// @brief Get the number of movement-phase moves played
+	/// @return Moves since the placement phase ended
+	int getMovesPlayed() const { return m_history.size() > 0 ? m_history.size() - 1 : 0; }
+
+private:
+	/// @brief Current position
+	Position m_position;
+	/// @brief Movement-phase positions, for threefold repetition
+	PositionHistory m_history;
+	/// @brief Last move of each side
+	Move m_lastMoves[2];
+	/// @brief State of the game
+	Result m_result = Result::InProgress;
+	/// @brief Movement-phase moves after which the game is drawn (0 for no limit)
+	int m_maxMoves;
+};
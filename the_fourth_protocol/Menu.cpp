@@ -55,7 +55,7 @@ void MenuButton::update(const sf::Vector2f& mousePos)
 	}
 }
 
-void MenuButton::draw(sf::RenderWindow& window)
+void MenuButton::draw(sf::RenderTarget& window)
 {
 	window.draw(m_shape);
 	window.draw(m_text);
@@ -501,7 +501,7 @@ bool Menu::handleClick(const sf::Vector2f& mousePos)
 	return false;
 }
 
-void Menu::render(sf::RenderWindow& window)
+void Menu::render(sf::RenderTarget& window)
 {
 	if (m_state == State::Hidden) {
 		return;
@@ -44,8 +44,8 @@ public:
 	void update(const sf::Vector2f& mousePos);
 
 	/// @brief Draw the button to the render window
-	/// @param window Window to draw to
-	void draw(sf::RenderWindow& window);
+	/// @param window Window (or cached layer) to draw to
+	void draw(sf::RenderTarget& window);
 
 	/// @brief Check if button contains a point
 	/// @param point Point to check
@@ -112,8 +112,8 @@ public:
 	bool handleClick(const sf::Vector2f& mousePos);
 
 	/// @brief Draw the menu
-	/// @param window Window to draw to
-	void render(sf::RenderWindow& window);
+	/// @param window Window (or cached layer) to draw to
+	void render(sf::RenderTarget& window);
 
 	/// @brief Get current menu state
 	/// @return Current state
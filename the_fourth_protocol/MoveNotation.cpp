@@ -0,0 +1,91 @@
+#include "MoveNotation.h"
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+	/// @brief Letter of each piece type, indexed by static_cast<int>(Piece::Type)
+	const char PIECE_LETTERS[] = { 'F', 'S', 'D', 'A', 'L' };
+	/// @brief Number of piece types
+	const int PIECE_TYPE_COUNT = 5;
+}
+
+char MoveNotation::pieceLetter(int type)
+{
+	return PIECE_LETTERS[type];
+}
+
+std::string MoveNotation::formatCell(int cell, int gridSize)
+{
+	return std::string(1, static_cast<char>('a' + cell % gridSize)) + std::to_string(cell / gridSize + 1);
+}
+
+int MoveNotation::parseCell(const std::string& text, int gridSize)
+{
+	if (text.size() < 2 || !std::isdigit(static_cast<unsigned char>(text[1]))) return -1;
+	const int col = std::tolower(static_cast<unsigned char>(text[0])) - 'a';
+	const int row = std::atoi(text.c_str() + 1) - 1;
+	if (col < 0 || col >= gridSize || row < 0 || row >= gridSize) return -1;
+	return row * gridSize + col;
+}
+
+std::string MoveNotation::format(const Position& position, const Move& move)
+{
+	const int gridSize = position.gridSize;
+	const int toCell = move.toRow * gridSize + move.toCol;
+	if (move.fromRow < 0) {
+		return std::string(1, pieceLetter(position.pieceTypes[position.sideToMove()][move.pieceIndex])) + "@" + formatCell(toCell, gridSize);
+	}
+	return formatCell(move.fromRow * gridSize + move.fromCol, gridSize) + "-" + formatCell(toCell, gridSize);
+}
+
+std::string MoveNotation::formatBoard(const Position& position)
+{
+	const int gridSize = position.gridSize;
+	std::string text;
+	text.reserve(gridSize * (gridSize + 1));
+	for (int cell = 0; cell < gridSize * gridSize; ++cell) {
+		if (cell > 0 && cell % gridSize == 0) text += '/';
+		if (position.isEmpty(cell)) {
+			text += '.';
+		} else {
+			const char letter = pieceLetter(position.typeAt(cell));
+			text += position.isPlayer1At(cell) ? letter : static_cast<char>(std::tolower(static_cast<unsigned char>(letter)));
+		}
+	}
+	return text;
+}
+
+bool MoveNotation::parse(const Position& position, const std::string& text, Move& move)
+{
+	const int side = position.sideToMove();
+	const int gridSize = position.gridSize;
+	const size_t at = text.find('@');
+	const size_t dash = text.find('-');
+
+	if (position.placementPhase && at == 1) {
+		const int cell = parseCell(text.substr(2), gridSize);
+		const char letter = static_cast<char>(std::toupper(static_cast<unsigned char>(text[0])));
+		if (cell < 0) return false;
+
+		for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+			if (PIECE_LETTERS[type] != letter) continue;
+			for (int i = 0; i < position.pieceCount[side]; ++i) {
+				if (position.pieceTypes[side][i] == type && position.pieceCells[side][i] == Position::NONE) {
+					move = Move(i, -1, -1, cell / gridSize, cell % gridSize);
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	if (!position.placementPhase && dash != std::string::npos) {
+		const int from = parseCell(text.substr(0, dash), gridSize);
+		const int to = parseCell(text.substr(dash + 1), gridSize);
+		if (from < 0 || to < 0 || position.isEmpty(from) || Position::sideOf(position.isPlayer1At(from)) != side) return false;
+
+		move = Move(position.cells[from] % Position::MAX_PIECES, from / gridSize, from % gridSize, to / gridSize, to % gridSize);
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file MoveNotation.h
+ * @brief Text form of moves and boards for the headless tools and logs
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the MoveNotation namespace, which writes and reads
+ * moves as short strings for the engine protocol and the game server.
+ * Cells are a column letter and a row number counted from the top left
+ * (a1, c4). A placement is a piece letter (F, S, D, A or L), '@' and a cell,
+ * such as D@c3; identical pieces are interchangeable, so any unplaced piece
+ * of that type is used. A movement is two cells, such as c3-c4. A board is
+ * its rows from the top separated by '/', one character per cell: the piece
+ * letter in upper case for Player 1, lower case for Player 2, '.' if empty.
+ */
+
+#pragma once
+#include <string>
+#include "AI.h"
+#include "Position.h"
+
+/// @brief Conversion between moves and their text form
+namespace MoveNotation {
+	/// @brief Get the letter of a piece type
+	/// @param type Piece type (static_cast of Piece::Type)
+	/// @return F, S, D, A or L
+	char pieceLetter(int type);
+
+	/// @brief Format a cell
+	/// @param cell Row-major cell index
+	/// @param gridSize Size of the game grid
+	/// @return Cell name such as c4
+	std::string formatCell(int cell, int gridSize);
+
+	/// @brief Parse a cell name
+	/// @param text Cell name such as c4
+	/// @param gridSize Size of the game grid
+	/// @return Row-major cell index, or -1 if the name is not a cell of the grid
+	int parseCell(const std::string& text, int gridSize);
+
+	/// @brief Format a move of the side to move
+	/// @param position Position the move is played from
+	/// @param move Move with the piece index into the mover's pieces
+	/// @return Move such as D@c3 or c3-c4
+	std::string format(const Position& position, const Move& move);
+
+	/// @brief Format the pieces on the board
+	/// @param position Position to write
+	/// @return Board such as ".F.../..d../...../...../....."
+	std::string formatBoard(const Position& position);
+
+	/// @brief Parse a move of the side to move
+	///
+	/// Only the form and the pieces are checked (the letter names an unplaced
+	/// piece, or the first cell holds one of the mover's pieces); whether the
+	/// piece may go there is left to the rules.
+	/// @param position Position the move is played from
+	/// @param text Move such as D@c3 or c3-c4
+	/// @param move Receives the move
+	/// @return False if the text does not name a move of the side to move
+	bool parse(const Position& position, const std::string& text, Move& move);
+}
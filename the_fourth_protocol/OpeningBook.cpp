@@ -0,0 +1,124 @@
+#include "OpeningBook.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+	const char BOOK_MAGIC[4] = { 'T', '4', 'O', 'B' };
+}
+
+bool OpeningBook::open(const std::string& path)
+{
+	close();
+	if (!m_file.open(path)) return false;
+
+	if (m_file.size() < sizeof(OpeningBookHeader)) {
+		close();
+		return false;
+	}
+
+	OpeningBookHeader header;
+	std::memcpy(&header, m_file.data(), sizeof(header));
+	uint64_t available = (m_file.size() - sizeof(header)) / sizeof(OpeningBookRecord);
+	if (std::memcmp(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) != 0 ||
+		header.version != VERSION || header.count > available) {
+		close();
+		return false;
+	}
+
+	m_records = reinterpret_cast<const OpeningBookRecord*>(m_file.data() + sizeof(header));
+	m_count = header.count;
+	return true;
+}
+
+void OpeningBook::close()
+{
+	m_file.close();
+	m_records = nullptr;
+	m_count = 0;
+}
+
+const OpeningBookRecord* OpeningBook::find(uint64_t key) const
+{
+	if (!m_records) return nullptr;
+
+	const OpeningBookRecord* last = m_records + m_count;
+	const OpeningBookRecord* it = std::lower_bound(m_records, last, key,
+		[](const OpeningBookRecord& record, uint64_t k) { return record.key < k; });
+
+	if (it != last && it->key == key) return it;
+	return nullptr;
+}
+
+bool OpeningBook::write(const std::string& path, std::vector<OpeningBookRecord> records)
+{
+	std::sort(records.begin(), records.end(),
+		[](const OpeningBookRecord& a, const OpeningBookRecord& b) { return a.key < b.key; });
+	records.erase(std::unique(records.begin(), records.end(),
+		[](const OpeningBookRecord& a, const OpeningBookRecord& b) { return a.key == b.key; }), records.end());
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out) return false;
+
+	OpeningBookHeader header;
+	std::memcpy(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+	header.version = VERSION;
+	header.count = records.size();
+
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(records.data()),
+		static_cast<std::streamsize>(records.size() * sizeof(OpeningBookRecord)));
+	return static_cast<bool>(out);
+}
+
+uint64_t OpeningBook::canonicalKey(const std::vector<int>& cells, int gridSize, bool isPlayer1ToMove, int& symmetry)
+{
+	uint64_t base = Zobrist::gridKey(gridSize) ^ Zobrist::placementKey();
+	if (isPlayer1ToMove) base ^= Zobrist::player1ToMoveKey();
+
+	uint64_t best = 0;
+	symmetry = 0;
+	for (int s = 0; s < SYMMETRY_COUNT; ++s) {
+		uint64_t hash = base;
+		for (int cell = 0; cell < gridSize * gridSize; ++cell) {
+			if (cells[cell] != EMPTY_CELL) {
+				hash ^= Zobrist::pieceKey(transformCell(cell, gridSize, s), cells[cell] % 2 == 0, cells[cell] / 2);
+			}
+		}
+		if (s == 0 || hash < best) {
+			best = hash;
+			symmetry = s;
+		}
+	}
+	return best;
+}
+
+int OpeningBook::transformCell(int cell, int gridSize, int symmetry)
+{
+	int row = cell / gridSize;
+	int col = cell % gridSize;
+	int last = gridSize - 1;
+	int newRow = row;
+	int newCol = col;
+
+	switch (symmetry) {
+		case 0: break;                                          // identity
+		case 1: newRow = col;        newCol = last - row; break; // rotate 90
+		case 2: newRow = last - row; newCol = last - col; break; // rotate 180
+		case 3: newRow = last - col; newCol = row;        break; // rotate 270
+		case 4: newRow = row;        newCol = last - col; break; // mirror left-right
+		case 5: newRow = last - row; newCol = col;        break; // mirror top-bottom
+		case 6: newRow = col;        newCol = row;        break; // main diagonal
+		case 7: newRow = last - col; newCol = last - row; break; // anti-diagonal
+	}
+	return newRow * gridSize + newCol;
+}
+
+int OpeningBook::inverseTransformCell(int cell, int gridSize, int symmetry)
+{
+	// Only the two quarter turns are not their own inverse
+	if (symmetry == 1) return transformCell(cell, gridSize, 3);
+	if (symmetry == 3) return transformCell(cell, gridSize, 1);
+	return transformCell(cell, gridSize, symmetry);
+}
@@ -0,0 +1,127 @@
+/**
+ * @file OpeningBook.h
+ * @brief Placement-phase opening book for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the OpeningBook class, a memory-mapped table of
+ * precomputed placement moves for the first plies of the game. Positions
+ * are keyed by their canonical hash (the smallest hash over the eight
+ * rotations and reflections of the board), so one entry serves every
+ * symmetric variation. Each entry stores one move per Strategy.
+ *
+ * File layout: an OpeningBookHeader followed by `count` OpeningBookRecords
+ * sorted by key. Books are generated offline by the book_builder tool.
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+/// @brief A placement move stored in the book, in the canonical board's coordinates
+struct OpeningBookMove {
+	/// @brief Type of the piece to place (static_cast of Piece::Type), -1 if no move is stored
+	int8_t pieceType;
+	/// @brief Target cell (row * gridSize + col) on the canonical board
+	int8_t cell;
+};
+
+/// @brief One book position with its move for every strategy
+struct OpeningBookRecord {
+	/// @brief Canonical position hash (see OpeningBook::canonicalKey)
+	uint64_t key;
+	/// @brief Best move for each Strategy, indexed by static_cast<int>(Strategy)
+	OpeningBookMove moves[6];
+	/// @brief Padding, always zero
+	uint8_t reserved[4];
+};
+static_assert(sizeof(OpeningBookRecord) == 24, "OpeningBookRecord is part of the file format");
+
+/// @brief Header at the start of an opening book file
+struct OpeningBookHeader {
+	/// @brief File identifier, always "T4OB"
+	char magic[4];
+	/// @brief File format version
+	uint32_t version;
+	/// @brief Number of records following the header
+	uint64_t count;
+};
+static_assert(sizeof(OpeningBookHeader) == 16, "OpeningBookHeader is part of the file format");
+
+/// @brief Memory-mapped opening book keyed by canonical position
+class OpeningBook
+{
+public:
+	/// @brief Current file format version
+	static const uint32_t VERSION = 1;
+	/// @brief Number of symmetries of a square board (4 rotations x 2 reflections)
+	static const int SYMMETRY_COUNT = 8;
+	/// @brief Value of an empty cell in the cell arrays passed to canonicalKey
+	static constexpr int EMPTY_CELL = -1;
+
+	/// @brief Map a book file and validate its header
+	/// @param path Path of the book file
+	/// @return True if the file was mapped and is a valid book, false otherwise
+	bool open(const std::string& path);
+
+	/// @brief Unmap the book file
+	void close();
+
+	/// @brief Check if a book file is mapped
+	/// @return True if lookups can succeed
+	bool isOpen() const { return m_records != nullptr; }
+
+	/// @brief Look up a canonical position
+	/// @param key Canonical position hash
+	/// @return Pointer to the stored record, or nullptr if the position is not in the book
+	const OpeningBookRecord* find(uint64_t key) const;
+
+	/// @brief Get the number of positions in the book
+	/// @return Number of records
+	uint64_t size() const { return m_count; }
+
+	/// @brief Sort records by key and write a book file
+	/// @param path Path of the book file to write
+	/// @param records Records to write, in any order
+	/// @return True if the whole file was written, false otherwise
+	static bool write(const std::string& path, std::vector<OpeningBookRecord> records);
+
+	/// @brief Encode a cell's occupant for canonicalKey
+	/// @param isPlayer1 True if the piece belongs to Player 1
+	/// @param type Piece type as an integer
+	/// @return Encoded occupant (never EMPTY_CELL)
+	static int encodeCell(bool isPlayer1, int type) { return type * 2 + (isPlayer1 ? 0 : 1); }
+
+	/// @brief Compute the canonical hash of a placement-phase position
+	/// @param cells Encoded occupant of every cell (row-major, EMPTY_CELL if empty)
+	/// @param gridSize Size of the game grid
+	/// @param isPlayer1ToMove True if Player 1 is the side to move
+	/// @param symmetry Receives the symmetry that maps this board onto the canonical board
+	/// @return Smallest position hash over all eight symmetries
+	static uint64_t canonicalKey(const std::vector<int>& cells, int gridSize, bool isPlayer1ToMove, int& symmetry);
+
+	/// @brief Map a cell through one of the eight board symmetries
+	/// @param cell Row-major cell index
+	/// @param gridSize Size of the game grid
+	/// @param symmetry Symmetry index in [0, SYMMETRY_COUNT)
+	/// @return Row-major index of the transformed cell
+	static int transformCell(int cell, int gridSize, int symmetry);
+
+	/// @brief Map a cell back through the inverse of a board symmetry
+	/// @param cell Row-major cell index on the transformed board
+	/// @param gridSize Size of the game grid
+	/// @param symmetry Symmetry index in [0, SYMMETRY_COUNT)
+	/// @return Row-major index of the original cell
+	static int inverseTransformCell(int cell, int gridSize, int symmetry);
+
+private:
+	/// @brief The mapped book file
+	MappedFile m_file;
+	/// @brief First record inside the mapping
+	const OpeningBookRecord* m_records = nullptr;
+	/// @brief Number of records inside the mapping
+	uint64_t m_count = 0;
+};
@@ -6,7 +6,8 @@
  * @version 1.0
  *
  * This file contains the Piece class which represents individual game pieces
- * with different types (Frog, Snake, Donkey) and their movement rules.
+ * with different types (Frog, Snake, Donkey) and their on-screen state.
+ * Movement rules live in Position and Rules, shared with the AI.
  */
 
 #pragma once
@@ -20,7 +21,7 @@ using namespace std;
 /// @brief Represents a game piece that can be placed and moved on the board
 /// 
 /// This class manages individual pieces in The Fourth Protocol game, including
-/// their type, position, movement validation, and rendering properties.
+/// their type, position, and rendering properties.
 class Piece
 {
 	public:
@@ -35,11 +36,12 @@ class Piece
 
     /// @brief Constructor to create a new piece
     /// @param type The type of piece (Frog, Snake, or Donkey)
-    /// @param texture Reference to the texture to use for rendering
+    /// @param texture Reference to the texture to use for rendering (the piece atlas)
+    /// @param textureRect Rectangle of the piece's image in the texture
     /// @param size Size of the piece in pixels
     /// @param startPos Initial position of the piece
     /// @param p1 True if this piece belongs to Player 1, false for Player 2
-    Piece(Type type, const sf::Texture& texture, float size, Vector2f startPos, bool p1);
+    Piece(Type type, const sf::Texture& texture, const sf::IntRect& textureRect, float size, Vector2f startPos, bool p1);
 
 	/// @brief Gets the type of this piece
 	/// @return The piece type (Frog, Snake, or Donkey)
@@ -60,6 +62,10 @@ class Piece
 	/// @brief Draws the piece to the render window
 	/// @param window Reference to the SFML render window
 	void draw(RenderWindow& window) const { window.draw(m_rect); };
+
+	/// @brief Gets the shape the piece is drawn as, for batching several pieces into one draw call
+	/// @return Textured rectangle at the piece's position
+	const RectangleShape& getShape() const { return m_rect; };
 	
 	/// @brief Checks if a point is contained within this piece's bounds
 	/// @param point Point to test for containment
@@ -93,20 +99,6 @@ class Piece
 	/// @param col Grid column position
 	void setGridPosition(int row, int col) { m_gridRow = row; m_gridCol = col; };
 
-	/// @brief Check if a move to the target position is valid for this piece
-	/// @param targetRow Target grid row
-	/// @param targetCol Target grid column
-	/// @param board Current board state with piece positions
-	/// @param gridSize Size of the game grid
-	/// @return True if move is valid according to piece movement rules, false otherwise
-	bool isValidMove(int targetRow, int targetCol, const vector<vector<Piece*>>& board, int gridSize);
-
-	/// @brief Get all valid moves available for this piece from its current position
-	/// @param board Current board state with piece positions
-	/// @param gridSize Size of the game grid
-	/// @return Vector of coordinate pairs representing all valid target positions
-	vector<pair<int, int>> getValidMoves(const vector<vector<Piece*>>& board, int gridSize);
-
 private:
 	/// @brief The type of this piece (affects movement rules)
 	Type m_type;
@@ -122,38 +114,5 @@ private:
 	int m_gridRow = -1;
 	/// @brief Current logical grid column position (-1 if not on board)
 	int m_gridCol = -1;
-
-	/// @brief Helper function to validate movement to a target position
-	/// @param targetRow Target grid row
-	/// @param targetCol Target grid column
-	/// @param board Current board state
-	/// @param gridSize Size of the game grid
-	/// @return True if move is allowed, false otherwise
-	bool canMoveTo(int targetRow, int targetCol, const vector<vector<Piece*>>& board, int gridSize);
-	
-	/// @brief Helper function to check if piece can jump to target (Frog-specific)
-	/// @param targetRow Target grid row
-	/// @param targetCol Target grid column
-	/// @param board Current board state
-	/// @param gridSize Size of the game grid
-	/// @return True if jump is valid, false otherwise
-	bool canJump(int targetRow, int targetCol, const vector<vector<Piece*>>& board, int gridSize);
-	
-	/// @brief Checks if two positions form a straight line (horizontal, vertical, diagonal)
-	/// @param fromRow Starting grid row
-	/// @param fromCol Starting grid column
-	/// @param toRow Target grid row
-	/// @param toCol Target grid column
-	/// @return True if positions form a line, false otherwise
-	bool isInLine(int fromRow, int fromCol, int toRow, int toCol);
-	
-	/// @brief Checks if the path between two positions is clear of other pieces
-	/// @param fromRow Starting grid row
-	/// @param fromCol Starting grid column
-	/// @param toRow Target grid row
-	/// @param toCol Target grid column
-	/// @param board Current board state
-	/// @return True if path is clear, false if blocked
-	bool isPathClear(int fromRow, int fromCol, int toRow, int toCol, const vector<vector<Piece*>>& board);
 };
 
@@ -0,0 +1,173 @@
+#include "PieceAtlas.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+	/// @brief Image file of each piece type, indexed by static_cast<int>(Piece::Type)
+	const char* const IMAGE_NAMES[] = { "frog.png", "snake.png", "donkey.png", "antelope.png", "lion.png" };
+	/// @brief Longest side of a piece image in the atlas; pieces are drawn far smaller than their source files
+	const unsigned MAX_IMAGE_SIZE = 128;
+	/// @brief Empty pixels between images, so scaled pieces never sample their neighbour
+	const unsigned PADDING = 2;
+	/// @brief Side of the white block
+	const unsigned WHITE_SIZE = 4;
+	const char PACK_MAGIC[4] = { 'T', '4', 'P', 'A' };
+	/// @brief Bytes per RGBA pixel
+	const uint64_t PIXEL_SIZE = 4;
+
+	/// @brief Shrink an image so its longest side is at most maxSize, averaging the pixels each target pixel covers
+	/// @param source Image to shrink (returned as is if it already fits)
+	/// @param maxSize Longest side allowed
+	/// @return Shrunk image
+	sf::Image downscale(const sf::Image& source, unsigned maxSize)
+	{
+		const sf::Vector2u size = source.getSize();
+		const unsigned longest = std::max(size.x, size.y);
+		if (longest <= maxSize) return source;
+
+		const sf::Vector2u target(std::max(1u, size.x * maxSize / longest), std::max(1u, size.y * maxSize / longest));
+		sf::Image result(target, sf::Color::Transparent);
+		for (unsigned y = 0; y < target.y; ++y) {
+			const unsigned top = y * size.y / target.y;
+			const unsigned bottom = std::max(top + 1, (y + 1) * size.y / target.y);
+			for (unsigned x = 0; x < target.x; ++x) {
+				const unsigned left = x * size.x / target.x;
+				const unsigned right = std::max(left + 1, (x + 1) * size.x / target.x);
+
+				// Colours are weighted by alpha so transparent pixels do not darken the edges
+				uint64_t red = 0, green = 0, blue = 0, alpha = 0;
+				for (unsigned sy = top; sy < bottom; ++sy) {
+					for (unsigned sx = left; sx < right; ++sx) {
+						const sf::Color pixel = source.getPixel({ sx, sy });
+						red += pixel.r * pixel.a;
+						green += pixel.g * pixel.a;
+						blue += pixel.b * pixel.a;
+						alpha += pixel.a;
+					}
+				}
+				if (alpha == 0) continue;
+				const uint64_t count = static_cast<uint64_t>(right - left) * (bottom - top);
+				result.setPixel({ x, y }, sf::Color(static_cast<uint8_t>(red / alpha), static_cast<uint8_t>(green / alpha),
+					static_cast<uint8_t>(blue / alpha), static_cast<uint8_t>(alpha / count)));
+			}
+		}
+		return result;
+	}
+}
+
+bool PieceAtlas::openPack(const std::string& path)
+{
+	MappedFile file;
+	if (!file.open(path) || file.size() < sizeof(PieceAtlasHeader)) return false;
+
+	PieceAtlasHeader header;
+	std::memcpy(&header, file.data(), sizeof(header));
+	const uint64_t pixelBytes = static_cast<uint64_t>(header.width) * header.height * PIXEL_SIZE;
+	if (std::memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 || header.version != VERSION ||
+		header.width == 0 || header.height == 0 || file.size() - sizeof(header) < pixelBytes) {
+		return false;
+	}
+
+	if (!m_texture.resize({ header.width, header.height })) return false;
+	m_texture.update(file.data() + sizeof(header));
+	for (int type = 0; type < TYPE_COUNT; ++type) {
+		m_rects[type] = sf::IntRect({ header.rects[type][0], header.rects[type][1] }, { header.rects[type][2], header.rects[type][3] });
+	}
+	m_whiteTexel = sf::Vector2f(header.whiteTexel[0], header.whiteTexel[1]);
+	return true;
+}
+
+bool PieceAtlas::writePack(const std::string& directory, const std::string& path)
+{
+	sf::Image atlas;
+	if (!packImages(directory, atlas)) return false;
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out) return false;
+
+	PieceAtlasHeader header;
+	std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+	header.version = VERSION;
+	header.width = atlas.getSize().x;
+	header.height = atlas.getSize().y;
+	for (int type = 0; type < TYPE_COUNT; ++type) {
+		header.rects[type][0] = m_rects[type].position.x;
+		header.rects[type][1] = m_rects[type].position.y;
+		header.rects[type][2] = m_rects[type].size.x;
+		header.rects[type][3] = m_rects[type].size.y;
+	}
+	header.whiteTexel[0] = m_whiteTexel.x;
+	header.whiteTexel[1] = m_whiteTexel.y;
+
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(atlas.getPixelsPtr()),
+		static_cast<std::streamsize>(static_cast<uint64_t>(header.width) * header.height * PIXEL_SIZE));
+	return static_cast<bool>(out);
+}
+
+bool PieceAtlas::loadImages(const std::string& directory)
+{
+	sf::Image atlas;
+	const bool loadedAll = packImages(directory, atlas);
+	if (!m_texture.loadFromImage(atlas)) {
+		std::cout << "Error creating the piece atlas texture\n";
+		return false;
+	}
+	return loadedAll;
+}
+
+bool PieceAtlas::packImages(const std::string& directory, sf::Image& atlas)
+{
+	bool loadedAll = true;
+	sf::Image images[TYPE_COUNT];
+	for (int type = 0; type < TYPE_COUNT; ++type) {
+		sf::Image source;
+		if (!source.loadFromFile(directory + IMAGE_NAMES[type])) {
+			std::cout << "Error loading " << directory << IMAGE_NAMES[type] << "\n";
+			loadedAll = false;
+			continue;
+		}
+		images[type] = downscale(source, MAX_IMAGE_SIZE);
+	}
+
+	// Images left to right in rows no wider than the largest texture the GPU accepts, then the white block
+	const unsigned maxWidth = sf::Texture::getMaximumSize();
+	sf::Vector2u positions[TYPE_COUNT + 1];
+	unsigned x = 0;
+	unsigned rowTop = 0;
+	unsigned rowHeight = 0;
+	unsigned width = 0;
+	for (int slot = 0; slot <= TYPE_COUNT; ++slot) {
+		const sf::Vector2u size = slot < TYPE_COUNT ? images[slot].getSize() : sf::Vector2u(WHITE_SIZE, WHITE_SIZE);
+		if (x > 0 && x + size.x > maxWidth) {
+			rowTop += rowHeight + PADDING;
+			rowHeight = 0;
+			x = 0;
+		}
+		positions[slot] = sf::Vector2u(x, rowTop);
+		width = std::max(width, x + size.x);
+		rowHeight = std::max(rowHeight, size.y);
+		x += size.x + PADDING;
+	}
+
+	atlas = sf::Image({ width, rowTop + rowHeight }, sf::Color::Transparent);
+	for (int type = 0; type < TYPE_COUNT; ++type) {
+		const sf::Vector2u size = images[type].getSize();
+		if (size.x > 0 && !atlas.copy(images[type], positions[type])) {
+			loadedAll = false;
+		}
+		m_rects[type] = sf::IntRect({ static_cast<int>(positions[type].x), static_cast<int>(positions[type].y) },
+			{ static_cast<int>(size.x), static_cast<int>(size.y) });
+	}
+	const sf::Vector2u white = positions[TYPE_COUNT];
+	for (unsigned row = 0; row < WHITE_SIZE; ++row) {
+		for (unsigned col = 0; col < WHITE_SIZE; ++col) {
+			atlas.setPixel({ white.x + col, white.y + row }, sf::Color::White);
+		}
+	}
+	m_whiteTexel = sf::Vector2f(white.x + WHITE_SIZE * 0.5f, white.y + WHITE_SIZE * 0.5f);
+	return loadedAll;
+}
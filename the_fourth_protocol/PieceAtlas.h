@@ -0,0 +1,104 @@
+/**
+ * @file PieceAtlas.h
+ * @brief Single texture holding every piece image
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the PieceAtlas class, which shrinks the five piece
+ * images to at most 128 pixels a side and packs them in rows into one
+ * texture, followed by a small block of opaque white.
+ * Pieces use sub-rectangles of it, so all of them can be drawn in a single
+ * batch with one texture bound; the white block lets untextured outlines
+ * share that batch.
+ *
+ * The atlas is normally read from a pack written by the atlas_packer tool,
+ * which the game project runs after each build: a PieceAtlasHeader followed
+ * by width * height RGBA pixels, already decoded, so startup maps the file
+ * and uploads it as is instead of decoding five PNGs. Without a pack the
+ * PNGs are packed at startup.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include "Piece.h"
+
+/// @brief Header at the start of a piece atlas pack
+struct PieceAtlasHeader {
+	/// @brief File identifier, always "T4PA"
+	char magic[4];
+	/// @brief File format version
+	uint32_t version;
+	/// @brief Atlas width in pixels
+	uint32_t width;
+	/// @brief Atlas height in pixels
+	uint32_t height;
+	/// @brief Left, top, width and height of each piece type's image, indexed by static_cast<int>(Piece::Type)
+	int32_t rects[5][4];
+	/// @brief Texture coordinates of the centre of the white block
+	float whiteTexel[2];
+};
+static_assert(sizeof(PieceAtlasHeader) == 104, "PieceAtlasHeader is part of the file format");
+
+/// @brief One texture with every piece type's image
+class PieceAtlas
+{
+public:
+	/// @brief Number of piece types in the atlas
+	static const int TYPE_COUNT = 5;
+	/// @brief Current pack format version
+	static const uint32_t VERSION = 1;
+
+	/// @brief Load the atlas from a pack written by writePack
+	///
+	/// The pixels are uploaded straight from the mapped file; the mapping is
+	/// released once the texture holds them.
+	/// @param path Path of the pack
+	/// @return False if the file is missing or not a valid pack (the atlas is unchanged)
+	bool openPack(const std::string& path);
+
+	/// @brief Pack the piece images into the atlas
+	///
+	/// Images that fail to load leave an empty slot, so their pieces are drawn
+	/// as plain coloured squares.
+	/// @param directory Directory holding frog.png, snake.png, donkey.png, antelope.png and lion.png
+	/// @return False if any image failed to load
+	bool loadImages(const std::string& directory);
+
+	/// @brief Pack the piece images and write them, decoded, as an atlas pack
+	/// @param directory Directory holding the piece images (see loadImages)
+	/// @param path Path of the pack to write
+	/// @return False if an image failed to load or the pack could not be written
+	bool writePack(const std::string& directory, const std::string& path);
+
+	/// @brief Get the atlas texture
+	/// @return Texture to bind when drawing pieces
+	const sf::Texture& getTexture() const { return m_texture; }
+
+	/// @brief Get where a piece type's image is in the atlas
+	/// @param type Piece type
+	/// @return Rectangle in atlas pixels
+	const sf::IntRect& getRect(Piece::Type type) const { return m_rects[static_cast<int>(type)]; }
+
+	/// @brief Get the texture coordinates of an opaque white texel
+	/// @return Centre of the white block
+	sf::Vector2f getWhiteTexel() const { return m_whiteTexel; }
+
+private:
+	/// @brief Shrink the piece images and lay them out in one image, recording where each went
+	///
+	/// Rows wrap before they would exceed sf::Texture::getMaximumSize().
+	/// @param directory Directory holding the piece images
+	/// @param atlas Receives the packed image
+	/// @return False if any image failed to load
+	bool packImages(const std::string& directory, sf::Image& atlas);
+
+	/// @brief Packed images
+	sf::Texture m_texture;
+	/// @brief Rectangle of each piece type, indexed by static_cast<int>(Piece::Type)
+	sf::IntRect m_rects[TYPE_COUNT];
+	/// @brief Centre of the white block
+	sf::Vector2f m_whiteTexel;
+};
@@ -0,0 +1,249 @@
+#include "Position.h"
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+namespace {
+	/// @brief Row and column step of a move
+	struct Offset {
+		int8_t row;
+		int8_t col;
+	};
+
+	// Offsets are listed in row-major order, so the targets they produce come out row-major too
+	const Offset DONKEY_OFFSETS[] = { { -1, 0 }, { 0, -1 }, { 0, 1 }, { 1, 0 } };
+	const Offset KING_OFFSETS[] = { { -1, -1 }, { -1, 0 }, { -1, 1 }, { 0, -1 }, { 0, 1 }, { 1, -1 }, { 1, 0 }, { 1, 1 } };
+	const Offset ANTELOPE_OFFSETS[] = { { -2, -1 }, { -2, 1 }, { -1, -2 }, { -1, 2 }, { 1, -2 }, { 1, 2 }, { 2, -1 }, { 2, 1 } };
+	const Offset LION_OFFSETS[] = {
+		{ -2, -2 }, { -2, -1 }, { -2, 0 }, { -2, 1 }, { -2, 2 }, { -1, -2 }, { -1, 2 }, { 0, -2 },
+		{ 0, 2 }, { 1, -2 }, { 1, 2 }, { 2, -2 }, { 2, -1 }, { 2, 0 }, { 2, 1 }, { 2, 2 }
+	};
+
+	/// @brief Collect the empty on-board cells at a list of offsets from a cell
+	template <class PositionType, int COUNT>
+	int offsetTargets(const PositionType& position, int from, const Offset (&offsets)[COUNT], int16_t* targets)
+	{
+		const int gridSize = position.gridSize;
+		const int fromRow = from / gridSize;
+		const int fromCol = from % gridSize;
+		int count = 0;
+		for (const Offset& offset : offsets) {
+			int row = fromRow + offset.row;
+			int col = fromCol + offset.col;
+			if (row < 0 || row >= gridSize || col < 0 || col >= gridSize) continue;
+			int cell = row * gridSize + col;
+			if (position.isEmpty(cell)) targets[count++] = static_cast<int16_t>(cell);
+		}
+		return count;
+	}
+}
+
+template <int WORDS>
+BasicPosition<WORDS> BasicPosition<WORDS>::start(int variant)
+{
+	const Variant& rules = Variants::get(variant);
+	BasicPosition position = {};
+	position.variant = static_cast<int8_t>(variant);
+	position.gridSize = static_cast<int8_t>(rules.gridSize);
+	position.player1ToMove = true;
+	position.placementPhase = true;
+	for (auto& cell : position.cells) cell = NONE;
+	for (int side = 0; side < 2; ++side) {
+		position.pieceCount[side] = static_cast<int8_t>(rules.pieceCount);
+		for (int i = 0; i < rules.pieceCount; ++i) {
+			position.pieceTypes[side][i] = static_cast<int8_t>(Variants::pieceType(i));
+			position.pieceCells[side][i] = NONE;
+		}
+	}
+	return position;
+}
+
+template <int WORDS>
+BasicPosition<WORDS> BasicPosition<WORDS>::fromBoard(const GameBoard& board, int variant, const vector<Piece>& mover, const vector<Piece>& opponent, bool isPlacementPhase)
+{
+	BasicPosition position = {};
+	position.variant = static_cast<int8_t>(variant);
+	position.gridSize = static_cast<int8_t>(board.gridSize);
+	position.player1ToMove = !mover.empty() && mover[0].isPlayer1();
+	position.placementPhase = isPlacementPhase;
+
+	const vector<Piece>* sides[2] = { &mover, &opponent };
+	if (!position.player1ToMove) swap(sides[0], sides[1]);
+	for (int side = 0; side < 2; ++side) {
+		const vector<Piece>& pieces = *sides[side];
+		position.pieceCount[side] = static_cast<int8_t>(pieces.size());
+		for (int i = 0; i < static_cast<int>(pieces.size()); ++i) {
+			position.pieceTypes[side][i] = static_cast<int8_t>(pieces[i].getType());
+			position.pieceCells[side][i] = NONE;
+		}
+	}
+
+	// Both boards share the row-major layout, so cells copy across by index
+	for (int cell = 0; cell < MAX_CELLS; ++cell) {
+		position.cells[cell] = NONE;
+		const Piece* piece = cell < board.gridSize * board.gridSize ? board.cells[cell] : nullptr;
+		if (!piece) continue;
+
+		int side = sideOf(piece->isPlayer1());
+		int index = static_cast<int>(piece - sides[side]->data());
+		position.cells[cell] = static_cast<int8_t>(side * MAX_PIECES + index);
+		position.pieceCells[side][index] = static_cast<int16_t>(cell);
+		position.placedCount[side]++;
+		position.occupancy[side].set(cell);
+		position.boardKey ^= Zobrist::pieceKey(cell, side == 0, position.pieceTypes[side][index]);
+	}
+	return position;
+}
+
+template <int WORDS>
+void BasicPosition<WORDS>::putPiece(int side, int piece, int cell)
+{
+	int16_t& pieceCell = pieceCells[side][piece];
+	const int type = pieceTypes[side][piece];
+	if (pieceCell == NONE) {
+		placedCount[side]++;
+	} else {
+		cells[pieceCell] = NONE;
+		occupancy[side].reset(pieceCell);
+		boardKey ^= Zobrist::pieceKey(pieceCell, side == 0, type);
+	}
+	pieceCell = static_cast<int16_t>(cell);
+	cells[cell] = static_cast<int8_t>(side * MAX_PIECES + piece);
+	occupancy[side].set(cell);
+	boardKey ^= Zobrist::pieceKey(cell, side == 0, type);
+}
+
+template <int WORDS>
+void BasicPosition<WORDS>::liftPiece(int side, int piece)
+{
+	int16_t& pieceCell = pieceCells[side][piece];
+	if (pieceCell == NONE) return;
+
+	cells[pieceCell] = NONE;
+	occupancy[side].reset(pieceCell);
+	boardKey ^= Zobrist::pieceKey(pieceCell, side == 0, pieceTypes[side][piece]);
+	pieceCell = NONE;
+	placedCount[side]--;
+}
+
+template <int WORDS>
+int BasicPosition<WORDS>::getTargets(int side, int piece, int16_t* targets) const
+{
+	const int from = pieceCells[side][piece];
+	if (from == NONE) return 0;
+
+	// Same movement rules as canReach, generated from each piece's offsets
+	switch (static_cast<Piece::Type>(pieceTypes[side][piece])) {
+		case Piece::Type::Antelope:
+			return offsetTargets(*this, from, ANTELOPE_OFFSETS, targets);
+		case Piece::Type::Lion:
+			return offsetTargets(*this, from, LION_OFFSETS, targets);
+		case Piece::Type::Donkey:
+			return offsetTargets(*this, from, DONKEY_OFFSETS, targets);
+		case Piece::Type::Snake:
+			return offsetTargets(*this, from, KING_OFFSETS, targets);
+		case Piece::Type::Frog:
+			break;
+		default:
+			return 0;
+	}
+
+	// Frog: the neighbour in each direction if it is empty, else the first empty cell past the run it starts
+	int count = 0;
+	for (const Offset& offset : KING_OFFSETS) {
+		int row = from / gridSize + offset.row;
+		int col = from % gridSize + offset.col;
+		while (row >= 0 && row < gridSize && col >= 0 && col < gridSize && cells[row * gridSize + col] != NONE) {
+			row += offset.row;
+			col += offset.col;
+		}
+		if (row < 0 || row >= gridSize || col < 0 || col >= gridSize) continue;
+
+		// Jumps can land further out than later directions' targets, so keep the list row-major
+		int16_t cell = static_cast<int16_t>(row * gridSize + col);
+		int i = count++;
+		for (; i > 0 && targets[i - 1] > cell; --i) targets[i] = targets[i - 1];
+		targets[i] = cell;
+	}
+	return count;
+}
+
+template <int WORDS>
+typename BasicPosition<WORDS>::Mask BasicPosition<WORDS>::emptyCellsNear(int radius) const
+{
+	Mask near = {};
+	bool anyPlaced = false;
+	for (int side = 0; side < 2; ++side) {
+		for (int piece = 0; piece < pieceCount[side]; ++piece) {
+			const int cell = pieceCells[side][piece];
+			if (cell == NONE) continue;
+
+			anyPlaced = true;
+			const int row = cell / gridSize;
+			const int col = cell % gridSize;
+			for (int r = max(0, row - radius); r <= min(gridSize - 1, row + radius); ++r) {
+				for (int c = max(0, col - radius); c <= min(gridSize - 1, col + radius); ++c) {
+					near.set(r * gridSize + c);
+				}
+			}
+		}
+	}
+
+	if (!anyPlaced) {
+		near.set((gridSize / 2) * gridSize + gridSize / 2);
+		return near;
+	}
+	return near.andNot(occupancy[0] | occupancy[1]);
+}
+
+template <int WORDS>
+bool BasicPosition<WORDS>::canReach(int side, int piece, int cell) const
+{
+	if (cells[cell] != NONE) return false;
+
+	const int from = pieceCells[side][piece];
+	const int fromRow = from / gridSize;
+	const int fromCol = from % gridSize;
+	const int toRow = cell / gridSize;
+	const int toCol = cell % gridSize;
+	const int rowDist = abs(toRow - fromRow);
+	const int colDist = abs(toCol - fromCol);
+	const bool isInLine = rowDist == 0 || colDist == 0 || rowDist == colDist;
+
+	// Movement rules of every piece type (getTargets generates the same cells)
+	switch (static_cast<Piece::Type>(pieceTypes[side][piece])) {
+		case Piece::Type::Antelope:
+			return (rowDist == 2 && colDist == 1) || (rowDist == 1 && colDist == 2);
+		case Piece::Type::Lion:
+			return (rowDist == 2 && colDist == 0) || (rowDist == 0 && colDist == 2) ||
+				(rowDist == 2 && colDist == 2) ||
+				(rowDist == 2 && colDist == 1) || (rowDist == 1 && colDist == 2);
+		case Piece::Type::Donkey:
+			return (rowDist == 1 && colDist == 0) || (rowDist == 0 && colDist == 1);
+		case Piece::Type::Snake:
+			return isInLine && rowDist <= 1 && colDist <= 1;
+		case Piece::Type::Frog:
+			break;
+		default:
+			return false;
+	}
+
+	if (!isInLine) return false;
+	if (rowDist <= 1 && colDist <= 1) return true;
+
+	// Frog: jump over an unbroken run of pieces starting right next to it, landing just past the run
+	const int rowDir = (toRow > fromRow) - (toRow < fromRow);
+	const int colDir = (toCol > fromCol) - (toCol < fromCol);
+	int row = fromRow + rowDir;
+	int col = fromCol + colDir;
+	int piecesJumped = 0;
+	while (row >= 0 && row < gridSize && col >= 0 && col < gridSize && cells[row * gridSize + col] != NONE) {
+		piecesJumped++;
+		row += rowDir;
+		col += colDir;
+	}
+	return piecesJumped > 0 && row == toRow && col == toCol;
+}
+
+template struct BasicPosition<1>;
+template struct BasicPosition<4>;
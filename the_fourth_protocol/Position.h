@@ -0,0 +1,188 @@
+/**
+ * @file Position.h
+ * @brief Compact plain-data game position for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the BasicPosition struct, the search-side view of a
+ * game. Unlike Piece, it has no SFML state: the board, every piece's type
+ * and cell, and whose turn it is are stored in fixed-size arrays, so a
+ * position is trivially copyable and can be handed to the AI (or a worker
+ * thread) by value without touching the rendered pieces.
+ *
+ * The storage is templated on the width of the occupancy masks. Position
+ * holds any variant, up to 15x15, and is what the game, Match and the tools
+ * keep. SmallPosition holds boards up to 8x8 in one mask word per side and
+ * 64 cells, well under half the size, and is what the AI searches on those
+ * boards.
+ */
+
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "GameBoard.h"
+#include "Piece.h"
+#include "Variants.h"
+#include "WideMask.h"
+#include "Zobrist.h"
+
+using namespace std;
+
+/// @brief Trivially-copyable game position used by the search
+///
+/// Cells are row-major (row * gridSize + col). Sides are indexed 0 for
+/// Player 1 and 1 for Player 2. Pieces keep the index they have in the
+/// owning player's piece vector, so moves map straight back onto Game.
+/// @tparam WORDS Number of 64-bit words in each occupancy mask
+template <int WORDS>
+struct BasicPosition {
+	/// @brief Occupancy mask type
+	typedef WideMask<WORDS> Mask;
+
+	/// @brief Largest supported grid size
+	static const int MAX_GRID_SIZE = WORDS == 1 ? 8 : GameBoard::MAX_GRID_SIZE;
+	/// @brief Largest number of cells on the board
+	static const int MAX_CELLS = MAX_GRID_SIZE * MAX_GRID_SIZE;
+	/// @brief Largest number of pieces per player
+	static const int MAX_PIECES = 7;
+	/// @brief Cell value for an empty cell, and piece cell for an unplaced piece
+	static constexpr int8_t NONE = -1;
+
+	/// @brief Occupancy mask of each side (bit = cell)
+	Mask occupancy[2];
+	/// @brief XOR of the Zobrist piece keys of every piece on the board
+	uint64_t boardKey;
+	/// @brief Index of the variant in the Variants table
+	int8_t variant;
+	/// @brief Size of the game grid
+	int8_t gridSize;
+	/// @brief True if Player 1 moves next
+	bool player1ToMove;
+	/// @brief True if in placement phase, false if in movement phase
+	bool placementPhase;
+	/// @brief Number of pieces owned by each side
+	int8_t pieceCount[2];
+	/// @brief Number of pieces each side has on the board
+	int8_t placedCount[2];
+	/// @brief Piece type (Piece::Type) of every piece, for [side][piece]
+	int8_t pieceTypes[2][MAX_PIECES];
+	/// @brief Cell of every piece (NONE if unplaced), for [side][piece]; cells go past int8_t on large boards
+	int16_t pieceCells[2][MAX_PIECES];
+	/// @brief Occupant of every cell: NONE, or side * MAX_PIECES + piece
+	int8_t cells[MAX_CELLS];
+
+	/// @brief Build a position from Game's board and the pieces of both players
+	/// @param board Board of the rendered pieces (same cell layout as Position)
+	/// @param variant Index of the variant being played
+	/// @param mover Pieces of the player to move
+	/// @param opponent Pieces of the other player
+	/// @param isPlacementPhase True if in placement phase, false if in movement phase
+	/// @return Position with the mover to move
+	static BasicPosition fromBoard(const GameBoard& board, int variant, const vector<Piece>& mover, const vector<Piece>& opponent, bool isPlacementPhase);
+
+	/// @brief Build the start of a game: an empty board with Player 1 to place
+	/// @param variant Index of the variant in the Variants table
+	/// @return Position with every piece unplaced
+	static BasicPosition start(int variant);
+
+	/// @brief Copy a position held with another mask width
+	/// @param other Position to copy (its board must fit in MAX_CELLS)
+	/// @return The same position in this storage
+	template <int OTHER>
+	static BasicPosition from(const BasicPosition<OTHER>& other)
+	{
+		BasicPosition position = {};
+		const int cellCount = other.gridSize * other.gridSize;
+		for (int side = 0; side < 2; ++side) {
+			for (int w = 0; w < WORDS && w < OTHER; ++w) position.occupancy[side].words[w] = other.occupancy[side].words[w];
+			position.pieceCount[side] = other.pieceCount[side];
+			position.placedCount[side] = other.placedCount[side];
+			for (int i = 0; i < MAX_PIECES; ++i) {
+				position.pieceTypes[side][i] = other.pieceTypes[side][i];
+				position.pieceCells[side][i] = other.pieceCells[side][i];
+			}
+		}
+		position.boardKey = other.boardKey;
+		position.variant = other.variant;
+		position.gridSize = other.gridSize;
+		position.player1ToMove = other.player1ToMove;
+		position.placementPhase = other.placementPhase;
+		for (int cell = 0; cell < MAX_CELLS; ++cell) position.cells[cell] = cell < cellCount ? other.cells[cell] : NONE;
+		return position;
+	}
+
+	/// @brief Get the side index of a player
+	/// @param isPlayer1 True for Player 1
+	/// @return 0 for Player 1, 1 for Player 2
+	static int sideOf(bool isPlayer1) { return isPlayer1 ? 0 : 1; }
+
+	/// @brief Get the key identifying this arrangement with this side to move, for repetition checks
+	/// @return Zobrist key of the board and side to move
+	uint64_t repetitionKey() const { return player1ToMove ? boardKey ^ Zobrist::player1ToMoveKey() : boardKey; }
+
+	/// @brief Get the side index of the player to move
+	/// @return 0 for Player 1, 1 for Player 2
+	int sideToMove() const { return sideOf(player1ToMove); }
+
+	/// @brief Check if a cell is empty
+	/// @param cell Row-major cell index
+	/// @return True if no piece is on the cell
+	bool isEmpty(int cell) const { return cells[cell] == NONE; }
+
+	/// @brief Check which player owns the piece on an occupied cell
+	/// @param cell Row-major cell index (must be occupied)
+	/// @return True if the piece belongs to Player 1
+	bool isPlayer1At(int cell) const { return cells[cell] < MAX_PIECES; }
+
+	/// @brief Get the type of the piece on an occupied cell
+	/// @param cell Row-major cell index (must be occupied)
+	/// @return Piece type as an integer (Piece::Type)
+	int typeAt(int cell) const { return pieceTypes[cells[cell] / MAX_PIECES][cells[cell] % MAX_PIECES]; }
+
+	/// @brief Put a piece on an empty cell, lifting it from its old cell if it was placed
+	/// @param side Side owning the piece
+	/// @param piece Index of the piece
+	/// @param cell Target cell
+	void putPiece(int side, int piece, int cell);
+
+	/// @brief Take a piece off the board (back to unplaced)
+	/// @param side Side owning the piece
+	/// @param piece Index of the piece
+	void liftPiece(int side, int piece);
+
+	/// @brief Largest number of cells getTargets can return (a Frog or Lion with every destination free)
+	static const int MAX_TARGETS = 16;
+
+	/// @brief List the cells a placed piece can move to, in row-major order
+	///
+	/// Only the piece's own move offsets (and the Frog's jump lines) are
+	/// looked at, so the cost does not grow with the board.
+	/// @param side Side owning the piece
+	/// @param piece Index of the piece
+	/// @param targets Receives up to MAX_TARGETS target cells
+	/// @return Number of targets written
+	int getTargets(int side, int piece, int16_t* targets) const;
+
+	/// @brief Get the empty cells within a Chebyshev distance of any piece on the board
+	/// @param radius Largest row and column distance from a piece
+	/// @return Mask of the empty cells near pieces (just the centre cell if the board is empty)
+	Mask emptyCellsNear(int radius) const;
+
+	/// @brief Check if a placed piece can reach a cell under its movement rules
+	/// @param side Side owning the piece
+	/// @param piece Index of the piece
+	/// @param cell Target cell
+	/// @return True if the move is legal
+	bool canReach(int side, int piece, int cell) const;
+};
+
+/// @brief Position of any variant (up to GameBoard::MAX_GRID_SIZE)
+typedef BasicPosition<4> Position;
+/// @brief Position of a board up to 8x8, one mask word per side
+typedef BasicPosition<1> SmallPosition;
+
+static_assert(is_trivially_copyable<Position>::value, "Position must stay plain data");
+static_assert(is_trivially_copyable<SmallPosition>::value, "SmallPosition must stay plain data");
+static_assert(Position::MAX_CELLS <= BoardMask::BITS, "Position must fit in a BoardMask");
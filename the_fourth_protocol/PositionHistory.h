@@ -0,0 +1,84 @@
+/**
+ * @file PositionHistory.h
+ * @brief Record of earlier positions for repetition draws
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the PositionHistory class, the list of Zobrist keys
+ * (Position::repetitionKey) of the positions reached so far. Game keeps one
+ * for the movement phase and the AI extends a copy of it along the search
+ * path, so both score a position reached for the third time as a draw.
+ * A small table of counts per key bucket answers the common "never seen
+ * this" case without scanning the list.
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/// @brief Stack of position keys with fast occurrence counting
+class PositionHistory
+{
+public:
+	/// @brief Number of occurrences of a position that draws the game
+	static const int REPETITION_LIMIT = 3;
+
+	/// @brief Forget every position
+	void clear()
+	{
+		m_keys.clear();
+		for (auto& count : m_bucketCounts) count = 0;
+	}
+
+	/// @brief Record a position
+	/// @param key Repetition key of the position
+	void push(uint64_t key)
+	{
+		m_keys.push_back(key);
+		m_bucketCounts[key % BUCKET_COUNT]++;
+	}
+
+	/// @brief Forget the most recently recorded position
+	void pop()
+	{
+		m_bucketCounts[m_keys.back() % BUCKET_COUNT]--;
+		m_keys.pop_back();
+	}
+
+	/// @brief Count how often a position has been recorded
+	/// @param key Repetition key of the position
+	/// @return Number of occurrences
+	int count(uint64_t key) const
+	{
+		if (m_bucketCounts[key % BUCKET_COUNT] == 0) return 0;
+
+		int occurrences = 0;
+		for (uint64_t stored : m_keys) {
+			if (stored == key) ++occurrences;
+		}
+		return occurrences;
+	}
+
+	/// @brief Check if a recorded position has now occurred REPETITION_LIMIT times
+	/// @param key Repetition key of the position
+	/// @return True if the position is drawn by repetition
+	bool isRepetitionDraw(uint64_t key) const
+	{
+		// Bucket counts never undercount, so a low one rules the draw out without a scan
+		return m_bucketCounts[key % BUCKET_COUNT] >= REPETITION_LIMIT && count(key) >= REPETITION_LIMIT;
+	}
+
+	/// @brief Get the number of recorded positions
+	/// @return Number of keys
+	int size() const { return static_cast<int>(m_keys.size()); }
+
+private:
+	/// @brief Number of key buckets (a power of two)
+	static const int BUCKET_COUNT = 1024;
+
+	/// @brief Keys in the order the positions were reached
+	std::vector<uint64_t> m_keys;
+	/// @brief Number of recorded keys in each bucket
+	uint16_t m_bucketCounts[BUCKET_COUNT] = {};
+};
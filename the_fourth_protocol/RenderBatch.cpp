@@ -0,0 +1,42 @@
+#include "RenderBatch.h"
+
+void RenderBatch::appendQuad(sf::VertexArray& vertices, const sf::FloatRect& rect, sf::Color color, const sf::FloatRect& texRect)
+{
+	const float left = rect.position.x;
+	const float top = rect.position.y;
+	const float right = left + rect.size.x;
+	const float bottom = top + rect.size.y;
+	const float texLeft = texRect.position.x;
+	const float texTop = texRect.position.y;
+	const float texRight = texLeft + texRect.size.x;
+	const float texBottom = texTop + texRect.size.y;
+
+	vertices.append({ { left, top }, color, { texLeft, texTop } });
+	vertices.append({ { right, top }, color, { texRight, texTop } });
+	vertices.append({ { right, bottom }, color, { texRight, texBottom } });
+	vertices.append({ { left, top }, color, { texLeft, texTop } });
+	vertices.append({ { right, bottom }, color, { texRight, texBottom } });
+	vertices.append({ { left, bottom }, color, { texLeft, texBottom } });
+}
+
+void RenderBatch::appendShape(sf::VertexArray& vertices, const sf::RectangleShape& shape, sf::Vector2f whiteTexel)
+{
+	const sf::Vector2f position = shape.getPosition();
+	const sf::Vector2f size = shape.getSize();
+	const sf::FloatRect white(whiteTexel, sf::Vector2f());
+
+	if (shape.getFillColor().a > 0) {
+		const sf::FloatRect texRect = shape.getTexture() ? sf::FloatRect(shape.getTextureRect()) : white;
+		appendQuad(vertices, sf::FloatRect(position, size), shape.getFillColor(), texRect);
+	}
+
+	const float thickness = shape.getOutlineThickness();
+	const sf::Color outline = shape.getOutlineColor();
+	if (thickness <= 0.0f || outline.a == 0) return;
+
+	// Top and bottom bands cover the corners, the side bands only the edges between them
+	appendQuad(vertices, sf::FloatRect({ position.x - thickness, position.y - thickness }, { size.x + 2.0f * thickness, thickness }), outline, white);
+	appendQuad(vertices, sf::FloatRect({ position.x - thickness, position.y + size.y }, { size.x + 2.0f * thickness, thickness }), outline, white);
+	appendQuad(vertices, sf::FloatRect({ position.x - thickness, position.y }, { thickness, size.y }), outline, white);
+	appendQuad(vertices, sf::FloatRect({ position.x + size.x, position.y }, { thickness, size.y }), outline, white);
+}
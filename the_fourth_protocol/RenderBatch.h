@@ -0,0 +1,37 @@
+/**
+ * @file RenderBatch.h
+ * @brief Vertex array batching of rectangle shapes
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the RenderBatch namespace, which appends rectangles to
+ * an sf::VertexArray of triangles so that a whole layer (the board grid, the
+ * side trays, the move indicators, or every piece) is drawn in one call
+ * instead of one call per shape. A shape becomes up to five quads: its fill
+ * and the four bands of its outline, which SFML draws outside the shape.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+
+/// @brief Helpers to build one-draw-call layers out of rectangles
+namespace RenderBatch {
+	/// @brief Append a rectangle as two triangles
+	/// @param vertices Triangle array to append to
+	/// @param rect Rectangle in world coordinates
+	/// @param color Vertex colour (multiplies the texture, if one is bound)
+	/// @param texRect Texture rectangle in pixels (ignored when drawn without a texture)
+	void appendQuad(sf::VertexArray& vertices, const sf::FloatRect& rect, sf::Color color, const sf::FloatRect& texRect);
+
+	/// @brief Append a rectangle shape with its outline
+	///
+	/// The shape must have no origin, rotation or scale, as every rectangle
+	/// in the game does. Untextured parts (the outline, or the fill of a shape
+	/// without a texture) sample whiteTexel, so they keep their plain colour
+	/// in a batch drawn with a texture.
+	/// @param vertices Triangle array to append to
+	/// @param shape Shape to append
+	/// @param whiteTexel Texture coordinates of an opaque white texel
+	void appendShape(sf::VertexArray& vertices, const sf::RectangleShape& shape, sf::Vector2f whiteTexel = sf::Vector2f());
+}
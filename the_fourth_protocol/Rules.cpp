@@ -0,0 +1,51 @@
+#include "Rules.h"
+#include <cassert>
+
+template <int WORDS>
+bool Rules::hasWon(const BasicPosition<WORDS>& position, int side)
+{
+	return Variants::get(position.variant).hasWon(toBoardMask(position.occupancy[side]));
+}
+
+template <int WORDS>
+bool Rules::completesLine(const BasicPosition<WORDS>& position, int side, int cell)
+{
+	return Variants::get(position.variant).completesLine(toBoardMask(position.occupancy[side]), cell);
+}
+
+template <int WORDS>
+Rules::Outcome Rules::playMove(BasicPosition<WORDS>& position, int side, int piece, int cell)
+{
+	position.putPiece(side, piece, cell);
+	const bool won = completesLine(position, side, cell);
+
+	// Games stop at the first win, so the local check must agree with the whole-board one
+	assert(won == hasWon(position, side));
+	return won ? Outcome::Won : Outcome::Played;
+}
+
+template <int WORDS>
+Rules::Outcome Rules::placePiece(BasicPosition<WORDS>& position, int side, int piece, int cell)
+{
+	if (position.pieceCells[side][piece] != BasicPosition<WORDS>::NONE || !position.isEmpty(cell)) return Outcome::Illegal;
+	return playMove(position, side, piece, cell);
+}
+
+template <int WORDS>
+Rules::Outcome Rules::movePiece(BasicPosition<WORDS>& position, int side, int piece, int cell)
+{
+	if (position.pieceCells[side][piece] == BasicPosition<WORDS>::NONE || !position.canReach(side, piece, cell)) return Outcome::Illegal;
+	return playMove(position, side, piece, cell);
+}
+
+// The search plays on SmallPosition up to 8x8; everything else uses Position
+template bool Rules::hasWon(const SmallPosition&, int);
+template bool Rules::hasWon(const Position&, int);
+template bool Rules::completesLine(const SmallPosition&, int, int);
+template bool Rules::completesLine(const Position&, int, int);
+template Rules::Outcome Rules::playMove(SmallPosition&, int, int, int);
+template Rules::Outcome Rules::playMove(Position&, int, int, int);
+template Rules::Outcome Rules::placePiece(SmallPosition&, int, int, int);
+template Rules::Outcome Rules::placePiece(Position&, int, int, int);
+template Rules::Outcome Rules::movePiece(SmallPosition&, int, int, int);
+template Rules::Outcome Rules::movePiece(Position&, int, int, int);
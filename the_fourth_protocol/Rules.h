@@ -0,0 +1,74 @@
+/**
+ * @file Rules.h
+ * @brief Move application and win detection shared by Game and AI
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the Rules namespace, the single place where a move is
+ * checked, played on a Position and tested for a win. Game calls it for
+ * every human and AI move and the AI calls it at every search node, so the
+ * two can no longer disagree. Only the player who just moved can have
+ * completed a line, and that line must pass through the cell the piece
+ * landed on, so the win test looks at the four lines through that one cell
+ * instead of the whole board. Every function works on both Position and
+ * SmallPosition.
+ */
+
+#pragma once
+#include "Position.h"
+
+/// @brief Game rules applied in place to a Position
+namespace Rules {
+	/// @brief Result of trying to play a move
+	enum class Outcome {
+		Illegal,	///< The move breaks the rules; the position is unchanged
+		Played,		///< The move was played and the game goes on
+		Won			///< The move was played and completed a line for the mover
+	};
+
+	/// @brief Check if a side has the variant's win length in a row anywhere on the board
+	///
+	/// Uses the variant's compiled whole-board check, for positions whose
+	/// last move is not known.
+	/// @param position Position to check
+	/// @param side Side to check (0 for Player 1, 1 for Player 2)
+	/// @return True if the side has a winning line
+	template <int WORDS>
+	bool hasWon(const BasicPosition<WORDS>& position, int side);
+
+	/// @brief Check if a side has the variant's win length in a row through one cell
+	/// @param position Position to check
+	/// @param side Side to check (0 for Player 1, 1 for Player 2)
+	/// @param cell Row-major cell index the line must pass through
+	/// @return True if the side has a winning line through the cell
+	template <int WORDS>
+	bool completesLine(const BasicPosition<WORDS>& position, int side, int cell);
+
+	/// @brief Play a move already known to be legal (placement or movement)
+	/// @param position Position to update in place
+	/// @param side Side owning the piece
+	/// @param piece Index of the piece
+	/// @param cell Target cell
+	/// @return Won if the move completed a line for the mover, else Played
+	template <int WORDS>
+	Outcome playMove(BasicPosition<WORDS>& position, int side, int piece, int cell);
+
+	/// @brief Place an unplaced piece on an empty cell
+	/// @param position Position to update in place
+	/// @param side Side owning the piece
+	/// @param piece Index of the piece
+	/// @param cell Target cell
+	/// @return Illegal if the piece is already placed or the cell is taken, else Played or Won
+	template <int WORDS>
+	Outcome placePiece(BasicPosition<WORDS>& position, int side, int piece, int cell);
+
+	/// @brief Move a placed piece under its movement rules
+	/// @param position Position to update in place
+	/// @param side Side owning the piece
+	/// @param piece Index of the piece
+	/// @param cell Target cell
+	/// @return Illegal if the piece cannot reach the cell, else Played or Won
+	template <int WORDS>
+	Outcome movePiece(BasicPosition<WORDS>& position, int side, int piece, int cell);
+}
@@ -0,0 +1,92 @@
+#include "Trace.h"
+#include <chrono>
+#include <fstream>
+#include <mutex>
+
+std::atomic<bool> Trace::s_enabled{ false };
+
+namespace {
+	/// @brief Process id written with every event (one process per trace)
+	const int PROCESS_ID = 1;
+
+	/// @brief Guards the file and the first-event flag
+	std::mutex s_mutex;
+	/// @brief Open trace file
+	std::ofstream s_file;
+	/// @brief True until the first event is written (events are comma-separated)
+	bool s_firstEvent = true;
+	/// @brief Time the trace was opened
+	std::chrono::steady_clock::time_point s_origin = std::chrono::steady_clock::now();
+	/// @brief Source of the small thread ids shown in the viewer
+	std::atomic<int> s_nextThreadId{ 1 };
+
+	/// @brief Get the trace id of the calling thread, numbering threads in order of first use
+	int threadId()
+	{
+		thread_local const int id = s_nextThreadId.fetch_add(1);
+		return id;
+	}
+
+	/// @brief Start an event line; the caller holds s_mutex
+	void beginEvent()
+	{
+		s_file << (s_firstEvent ? "\n" : ",\n");
+		s_firstEvent = false;
+	}
+}
+
+bool Trace::open(const std::string& path)
+{
+	close();
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+	s_file.open(path, std::ios::trunc);
+	if (!s_file.is_open()) return false;
+
+	s_file << "[";
+	s_firstEvent = true;
+	s_origin = std::chrono::steady_clock::now();
+	s_enabled = true;
+	return true;
+}
+
+void Trace::close()
+{
+	s_enabled = false;
+
+	std::lock_guard<std::mutex> lock(s_mutex);
+	if (!s_file.is_open()) return;
+	s_file << "\n]\n";
+	s_file.close();
+}
+
+void Trace::setThreadName(const char* name)
+{
+	if (!isEnabled()) return;
+
+	const int tid = threadId();
+	std::lock_guard<std::mutex> lock(s_mutex);
+	if (!s_file.is_open()) return;
+	beginEvent();
+	s_file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << PROCESS_ID << ",\"tid\":" << tid
+		<< ",\"args\":{\"name\":\"" << name << "\"}}";
+}
+
+int64_t Trace::now()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - s_origin).count();
+}
+
+void Trace::writeZone(const char* name, int64_t start, int64_t duration, const char* argName, int64_t argValue)
+{
+	const int tid = threadId();
+	std::lock_guard<std::mutex> lock(s_mutex);
+	if (!s_file.is_open()) return;
+
+	// A complete ("X") event carries both ends of the zone
+	beginEvent();
+	s_file << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"ts\":" << start << ",\"dur\":" << duration
+		<< ",\"pid\":" << PROCESS_ID << ",\"tid\":" << tid;
+	if (argName) s_file << ",\"args\":{\"" << argName << "\":" << argValue << "}";
+	s_file << "}";
+}
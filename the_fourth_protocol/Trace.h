@@ -0,0 +1,93 @@
+/**
+ * @file Trace.h
+ * @brief Scoped profiling zones written as a Chrome trace
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the Trace class, which records how long marked zones
+ * of the game loop and the AI search take on every thread and writes them
+ * to a file in the Chrome trace event format, so a trace taken on a player's
+ * machine can be opened straight in Perfetto (ui.perfetto.dev) or
+ * chrome://tracing. Tracing is off unless a file was opened; a zone then
+ * costs one relaxed atomic load. Each event is one line of a JSON array
+ * whose closing bracket is optional in the format, so a trace cut short by
+ * a crash still loads.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/// @brief Process-wide trace file that Trace::Zone objects report to
+class Trace
+{
+public:
+	/// @brief Start tracing to a file, replacing any trace already open
+	/// @param path Path of the trace file (overwritten)
+	/// @return True if the file was opened, false otherwise (tracing stays off)
+	static bool open(const std::string& path);
+
+	/// @brief Stop tracing and finish the file
+	static void close();
+
+	/// @brief Check if a trace file is open
+	/// @return True if zones are being recorded
+	static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+	/// @brief Name the calling thread in the trace viewer
+	/// @param name Thread name (a string literal)
+	static void setThreadName(const char* name);
+
+	/// @brief Time since the trace was opened, the trace's clock
+	/// @return Microseconds
+	static int64_t now();
+
+	/// @brief Record a finished zone of the calling thread
+	/// @param name Zone name (a string literal)
+	/// @param start Start time from now()
+	/// @param duration Duration in microseconds
+	/// @param argName Name of an integer shown with the zone (nullptr for none)
+	/// @param argValue Value of the integer
+	static void writeZone(const char* name, int64_t start, int64_t duration, const char* argName, int64_t argValue);
+
+	/// @brief Times the scope it lives in and records it when destroyed
+	///
+	/// Zones nest: a zone opened inside another shows under it in the viewer.
+	class Zone
+	{
+	public:
+		/// @brief Start a zone if tracing is on
+		/// @param name Zone name (a string literal; it is kept, not copied)
+		/// @param argName Name of an integer shown with the zone (nullptr for none)
+		/// @param argValue Value of the integer
+		explicit Zone(const char* name, const char* argName = nullptr, int64_t argValue = 0)
+			: m_name(isEnabled() ? name : nullptr), m_argName(argName), m_argValue(argValue), m_start(m_name ? now() : 0)
+		{
+		}
+
+		/// @brief End the zone and record it
+		~Zone()
+		{
+			if (m_name) writeZone(m_name, m_start, now() - m_start, m_argName, m_argValue);
+		}
+
+		Zone(const Zone&) = delete;
+		Zone& operator=(const Zone&) = delete;
+
+	private:
+		/// @brief Zone name, or nullptr if tracing was off when the zone started
+		const char* m_name;
+		/// @brief Name of the integer shown with the zone (nullptr for none)
+		const char* m_argName;
+		/// @brief Value of the integer shown with the zone
+		int64_t m_argValue;
+		/// @brief Start time from now()
+		int64_t m_start;
+	};
+
+private:
+	/// @brief True while a trace file is open
+	static std::atomic<bool> s_enabled;
+};
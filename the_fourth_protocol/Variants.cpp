@@ -0,0 +1,59 @@
+#include "Variants.h"
+#include "Board.h"
+
+namespace {
+	/// @brief Every playable variant; keep one entry per grid size
+	///
+	/// Boards above 8x8 are too big to place everywhere at every ply, so the
+	/// AI only considers placements within two cells of a piece on them.
+	const Variant VARIANTS[] = {
+		{ "5x5", 5, 4, 5, 0, &Board<5, 4>::hasWonBoard, &Board<5, 4>::completesLineBoard },
+		{ "6x6", 6, 4, 6, 0, &Board<6, 4>::hasWonBoard, &Board<6, 4>::completesLineBoard },
+		{ "7x7", 7, 4, 7, 0, &Board<7, 4>::hasWonBoard, &Board<7, 4>::completesLineBoard },
+		{ "8x8-5", 8, 5, 7, 0, &Board<8, 5>::hasWonBoard, &Board<8, 5>::completesLineBoard },
+		{ "9x9-5", 9, 5, 7, 2, &Board<9, 5>::hasWonBoard, &Board<9, 5>::completesLineBoard },
+		{ "10x10-5", 10, 5, 7, 2, &Board<10, 5>::hasWonBoard, &Board<10, 5>::completesLineBoard },
+		{ "11x11-5", 11, 5, 7, 2, &Board<11, 5>::hasWonBoard, &Board<11, 5>::completesLineBoard },
+		{ "12x12-5", 12, 5, 7, 2, &Board<12, 5>::hasWonBoard, &Board<12, 5>::completesLineBoard },
+		{ "13x13-5", 13, 5, 7, 2, &Board<13, 5>::hasWonBoard, &Board<13, 5>::completesLineBoard },
+		{ "14x14-5", 14, 5, 7, 2, &Board<14, 5>::hasWonBoard, &Board<14, 5>::completesLineBoard },
+		{ "15x15-5", 15, 5, 7, 2, &Board<15, 5>::hasWonBoard, &Board<15, 5>::completesLineBoard }
+	};
+
+	const int VARIANT_COUNT = static_cast<int>(sizeof(VARIANTS) / sizeof(VARIANTS[0]));
+}
+
+int Variants::count()
+{
+	return VARIANT_COUNT;
+}
+
+const Variant& Variants::get(int index)
+{
+	return VARIANTS[index];
+}
+
+int Variants::find(const std::string& name)
+{
+	for (int i = 0; i < VARIANT_COUNT; ++i) {
+		if (name == VARIANTS[i].name) return i;
+	}
+	return -1;
+}
+
+int Variants::findByGridSize(int gridSize)
+{
+	for (int i = 0; i < VARIANT_COUNT; ++i) {
+		if (VARIANTS[i].gridSize == gridSize) return i;
+	}
+	return -1;
+}
+
+Piece::Type Variants::pieceType(int index)
+{
+	static const Piece::Type order[] = {
+		Piece::Type::Frog, Piece::Type::Snake, Piece::Type::Donkey, Piece::Type::Donkey,
+		Piece::Type::Donkey, Piece::Type::Antelope, Piece::Type::Lion
+	};
+	return order[index];
+}
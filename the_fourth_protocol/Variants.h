@@ -0,0 +1,66 @@
+/**
+ * @file Variants.h
+ * @brief Table of playable board variants for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the Variant struct and the Variants table. A variant
+ * is a grid size, a win length and a piece set. Its win checks are a
+ * Board<N, K> instantiation, so each variant gets rules compiled for its
+ * exact dimensions while the rest of the game picks one at runtime.
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include "Piece.h"
+#include "WideMask.h"
+
+/// @brief One playable combination of board size, win length and pieces
+struct Variant {
+	/// @brief Name used on the command line, e.g. "7x7"
+	const char* name;
+	/// @brief Size of the game grid
+	int gridSize;
+	/// @brief Number of pieces in a row needed to win
+	int winLength;
+	/// @brief Pieces per player, taken in order from Variants::pieceType
+	int pieceCount;
+	/// @brief How far from existing pieces the AI looks for placements (0 = the whole board)
+	int placementRadius;
+	/// @brief Win check compiled for this board (Board<gridSize, winLength>::hasWonBoard)
+	bool (*hasWon)(const BoardMask& mask);
+	/// @brief Win check through one cell compiled for this board (Board<gridSize, winLength>::completesLineBoard)
+	bool (*completesLine)(const BoardMask& mask, int cell);
+};
+
+/// @brief The variants the game can be played with
+///
+/// Every variant has a different grid size, so the grid size alone keeps
+/// their analysis cache and opening book entries apart.
+namespace Variants {
+	/// @brief Number of variants in the table
+	/// @return Variant count
+	int count();
+
+	/// @brief Get a variant by table index
+	/// @param index Index from 0 to count() - 1
+	/// @return The variant
+	const Variant& get(int index);
+
+	/// @brief Find a variant by name
+	/// @param name Name such as "5x5" or "15x15-5"
+	/// @return Table index, or -1 if there is no such variant
+	int find(const std::string& name);
+
+	/// @brief Find the variant played on a grid size
+	/// @param gridSize Size of the game grid
+	/// @return Table index, or -1 if no variant uses that size
+	int findByGridSize(int gridSize);
+
+	/// @brief Get the type of the n-th piece of a set (Frog, Snake, three Donkeys, Antelope, Lion)
+	/// @param index Position of the piece in the set
+	/// @return Piece type
+	Piece::Type pieceType(int index);
+}
@@ -0,0 +1,225 @@
+/**
+ * @file WideMask.h
+ * @brief Multi-word cell masks for boards larger than 8x8
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the WideMask struct, a bitset of WORDS 64-bit words
+ * with the same bit layout as a single-word board mask (bit row * gridSize
+ * + col, counting up from bit 0 of word 0). Bitwise operators work on two
+ * words per SSE2 register where available, and shifts carry bits across
+ * word boundaries, so the shifted-AND run detection used for small boards
+ * works unchanged on 128- and 256-bit masks. BoardMask is the widest mask
+ * and holds any supported board.
+ */
+
+#pragma once
+#include <cstdint>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define T4P_WIDE_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/// @brief Index of the lowest set bit of a word
+/// @param word Non-zero word
+/// @return Bit index from 0 to 63
+inline int lowestBit(uint64_t word)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(word);
+#else
+	int index = 0;
+	while (!((word >> index) & 1)) ++index;
+	return index;
+#endif
+}
+
+/// @brief Bitset of WORDS 64-bit words, bit n in word n / 64
+/// @tparam WORDS Number of 64-bit words
+template <int WORDS>
+struct alignas(WORDS % 2 == 0 ? 16 : 8) WideMask {
+	static_assert(WORDS >= 1, "A mask needs at least one word");
+
+	/// @brief Number of bits in the mask
+	static const int BITS = WORDS * 64;
+
+	/// @brief Mask words, least significant first
+	uint64_t words[WORDS];
+
+	/// @brief Set a bit
+	/// @param bit Bit index (cell)
+	constexpr void set(int bit) { words[bit >> 6] |= 1ULL << (bit & 63); }
+
+	/// @brief Clear a bit
+	/// @param bit Bit index (cell)
+	constexpr void reset(int bit) { words[bit >> 6] &= ~(1ULL << (bit & 63)); }
+
+	/// @brief Flip a bit
+	/// @param bit Bit index (cell)
+	constexpr void flip(int bit) { words[bit >> 6] ^= 1ULL << (bit & 63); }
+
+	/// @brief Check a bit
+	/// @param bit Bit index (cell)
+	/// @return True if the bit is set
+	constexpr bool test(int bit) const { return (words[bit >> 6] >> (bit & 63)) & 1; }
+
+	/// @brief Get the mask with a bit set
+	/// @param index Bit index (cell)
+	/// @return Single-bit mask
+	static constexpr WideMask bit(int index)
+	{
+		WideMask mask = {};
+		mask.set(index);
+		return mask;
+	}
+
+	/// @brief Shift every bit towards bit 0, carrying across words
+	/// @param count Number of bits to shift by (0 to 63)
+	/// @return Shifted mask
+	WideMask operator>>(int count) const
+	{
+		WideMask result;
+		if (count == 0) return *this;
+		for (int i = 0; i < WORDS - 1; ++i) {
+			result.words[i] = (words[i] >> count) | (words[i + 1] << (64 - count));
+		}
+		result.words[WORDS - 1] = words[WORDS - 1] >> count;
+		return result;
+	}
+
+	/// @brief Shift every bit away from bit 0, carrying across words
+	/// @param count Number of bits to shift by (0 to 63)
+	/// @return Shifted mask
+	WideMask operator<<(int count) const
+	{
+		WideMask result;
+		if (count == 0) return *this;
+		for (int i = WORDS - 1; i > 0; --i) {
+			result.words[i] = (words[i] << count) | (words[i - 1] >> (64 - count));
+		}
+		result.words[0] = words[0] << count;
+		return result;
+	}
+
+	WideMask operator&(const WideMask& other) const { return combine<And>(other); }
+	WideMask operator|(const WideMask& other) const { return combine<Or>(other); }
+	WideMask operator^(const WideMask& other) const { return combine<Xor>(other); }
+	WideMask& operator&=(const WideMask& other) { return *this = *this & other; }
+	WideMask& operator|=(const WideMask& other) { return *this = *this | other; }
+	WideMask& operator^=(const WideMask& other) { return *this = *this ^ other; }
+
+	/// @brief Get the bits of this mask that are not in another
+	/// @param other Bits to remove
+	/// @return this & ~other
+	WideMask andNot(const WideMask& other) const { return combine<AndNot>(other); }
+
+	/// @brief Check if any bit is set
+	/// @return True if the mask is not empty
+	bool any() const
+	{
+		uint64_t bits = 0;
+		for (int i = 0; i < WORDS; ++i) bits |= words[i];
+		return bits != 0;
+	}
+
+	bool operator==(const WideMask& other) const
+	{
+		for (int i = 0; i < WORDS; ++i) {
+			if (words[i] != other.words[i]) return false;
+		}
+		return true;
+	}
+	bool operator!=(const WideMask& other) const { return !(*this == other); }
+
+private:
+	enum Op { And, Or, Xor, AndNot };
+
+	/// @brief Apply a bitwise operation word by word, two words per SSE2 register when the width allows
+	template <Op OP>
+	WideMask combine(const WideMask& other) const
+	{
+		WideMask result;
+		int i = 0;
+#ifdef T4P_WIDE_SSE2
+		for (; i + 2 <= WORDS; i += 2) {
+			__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+			__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(other.words + i));
+			__m128i r = OP == And ? _mm_and_si128(a, b)
+				: OP == Or ? _mm_or_si128(a, b)
+				: OP == Xor ? _mm_xor_si128(a, b)
+				: _mm_andnot_si128(b, a);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(result.words + i), r);
+		}
+#endif
+		for (; i < WORDS; ++i) {
+			result.words[i] = OP == And ? words[i] & other.words[i]
+				: OP == Or ? words[i] | other.words[i]
+				: OP == Xor ? words[i] ^ other.words[i]
+				: words[i] & ~other.words[i];
+		}
+		return result;
+	}
+};
+
+/// @brief Mask wide enough for the largest supported board (16 x 16 cells)
+typedef WideMask<4> BoardMask;
+
+/// @brief Widen a mask to a BoardMask, clearing the words above it
+/// @param mask Mask of at most BoardMask::BITS bits
+/// @return The same bits in a BoardMask
+template <int WORDS>
+BoardMask toBoardMask(const WideMask<WORDS>& mask)
+{
+	static_assert(WORDS <= 4, "Mask must fit in a BoardMask");
+	BoardMask result = {};
+	for (int i = 0; i < WORDS; ++i) result.words[i] = mask.words[i];
+	return result;
+}
+
+/// @brief A BoardMask is already full width
+inline const BoardMask& toBoardMask(const BoardMask& mask) { return mask; }
+
+/// @brief The narrowest mask type holding a number of cells, and how to take it from a BoardMask
+/// @tparam WORDS Number of 64-bit words needed
+template <int WORDS>
+struct MaskWords {
+	typedef WideMask<WORDS> type;
+
+	/// @brief Keep the low WORDS words of a board mask
+	static type from(const BoardMask& mask)
+	{
+		type result;
+		for (int i = 0; i < WORDS; ++i) result.words[i] = mask.words[i];
+		return result;
+	}
+
+	/// @brief Get the mask with one bit set
+	static type bit(int index) { return type::bit(index); }
+
+	/// @brief Check if any bit is set
+	static bool any(const type& mask) { return mask.any(); }
+};
+
+/// @brief Boards of up to 64 cells stay plain 64-bit integers
+template <>
+struct MaskWords<1> {
+	typedef uint64_t type;
+
+	/// @brief Keep the low word of a board mask
+	static type from(const BoardMask& mask) { return mask.words[0]; }
+
+	/// @brief Get the mask with one bit set
+	static type bit(int index) { return 1ULL << index; }
+
+	/// @brief Check if any bit is set
+	static bool any(type mask) { return mask != 0; }
+};
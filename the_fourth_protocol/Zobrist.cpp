@@ -0,0 +1,77 @@
+#include "Zobrist.h"
+
+namespace {
+	/// @brief SplitMix64 step, used to expand the constant seed into keys
+	uint64_t splitMix64(uint64_t& state)
+	{
+		uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+	/// @brief Cells covered by the original key table (boards up to 8x8)
+	const int SMALL_BOARD_CELLS = 64;
+
+	/// @brief All key tables, filled once in a fixed order from a fixed seed
+	struct KeyTables {
+		uint64_t pieces[SMALL_BOARD_CELLS][2][Zobrist::MAX_PIECE_TYPES];
+		uint64_t player1ToMove;
+		uint64_t placement;
+		uint64_t strategies[Zobrist::MAX_STRATEGIES];
+		uint64_t grids[Zobrist::MAX_GRID_SIZE + 1];
+		uint64_t largeBoardPieces[Zobrist::MAX_CELLS - SMALL_BOARD_CELLS][2][Zobrist::MAX_PIECE_TYPES];
+
+		KeyTables()
+		{
+			// Never change the seed or the fill order: it would invalidate every data file on disk
+			uint64_t state = 0x4F50524F544F434CULL;
+			for (auto& cell : pieces)
+				for (auto& owner : cell)
+					for (auto& key : owner)
+						key = splitMix64(state);
+			player1ToMove = splitMix64(state);
+			placement = splitMix64(state);
+			for (auto& key : strategies) key = splitMix64(state);
+			for (auto& key : grids) key = splitMix64(state);
+
+			// Cells past 64 came later; their keys follow everything else so older keys are unchanged
+			for (auto& cell : largeBoardPieces)
+				for (auto& owner : cell)
+					for (auto& key : owner)
+						key = splitMix64(state);
+		}
+	};
+
+	const KeyTables& keys()
+	{
+		static const KeyTables tables;
+		return tables;
+	}
+}
+
+uint64_t Zobrist::pieceKey(int cell, bool isPlayer1, int type)
+{
+	if (cell >= SMALL_BOARD_CELLS) return keys().largeBoardPieces[cell - SMALL_BOARD_CELLS][isPlayer1 ? 0 : 1][type];
+	return keys().pieces[cell][isPlayer1 ? 0 : 1][type];
+}
+
+uint64_t Zobrist::player1ToMoveKey()
+{
+	return keys().player1ToMove;
+}
+
+uint64_t Zobrist::placementKey()
+{
+	return keys().placement;
+}
+
+uint64_t Zobrist::strategyKey(int strategy)
+{
+	return keys().strategies[strategy];
+}
+
+uint64_t Zobrist::gridKey(int gridSize)
+{
+	return keys().grids[gridSize];
+}
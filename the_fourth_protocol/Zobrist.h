@@ -0,0 +1,51 @@
+/**
+ * @file Zobrist.h
+ * @brief Zobrist hashing keys for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * This file contains the fixed random keys used to hash board positions.
+ * The keys are generated from a constant seed so that every build and every
+ * process produces identical hashes, which on-disk data files rely on.
+ */
+
+#pragma once
+#include <cstdint>
+
+/// @brief Deterministic Zobrist keys for hashing board positions
+namespace Zobrist {
+	/// @brief Largest number of board cells that can be hashed (a 16x16 board)
+	constexpr int MAX_CELLS = 256;
+	/// @brief Number of distinct piece types that can be hashed
+	constexpr int MAX_PIECE_TYPES = 8;
+	/// @brief Number of distinct evaluation strategies that can be hashed
+	constexpr int MAX_STRATEGIES = 8;
+	/// @brief Largest grid size that can be hashed
+	constexpr int MAX_GRID_SIZE = 16;
+
+	/// @brief Key for a piece standing on a cell
+	/// @param cell Row-major cell index (row * gridSize + col)
+	/// @param isPlayer1 True if the piece belongs to Player 1
+	/// @param type Piece type as an integer (static_cast of Piece::Type)
+	/// @return 64-bit key to XOR into the position hash
+	uint64_t pieceKey(int cell, bool isPlayer1, int type);
+
+	/// @brief Key XORed in when Player 1 is the side to move
+	/// @return 64-bit key
+	uint64_t player1ToMoveKey();
+
+	/// @brief Key XORed in while the game is in the placement phase
+	/// @return 64-bit key
+	uint64_t placementKey();
+
+	/// @brief Key identifying the evaluation strategy of a stored search
+	/// @param strategy Strategy as an integer (static_cast of Strategy)
+	/// @return 64-bit key
+	uint64_t strategyKey(int strategy);
+
+	/// @brief Key identifying the grid size, so 5x5 and 7x7 positions never collide
+	/// @param gridSize Size of the game grid
+	/// @return 64-bit key
+	uint64_t gridKey(int gridSize);
+}
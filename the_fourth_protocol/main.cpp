@@ -27,19 +27,95 @@
 
 
 #include "Game.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+/**
+ * @brief Reads the launch options from the command line
+ * 
+ * Recognised options:
+ *  --analysis-cache <file>    memory-map this analysis cache ("" disables it)
+ *  --analysis-journal <file>  append new AI search results to this journal
+ *  --opening-book <file>      memory-map this opening book ("" disables it)
+ *  --piece-atlas <file>       memory-map this pre-decoded piece atlas ("" packs the PNGs at startup)
+ *  --variant <name>           play a board variant, e.g. 6x6 or 15x15-5 (default: from difficulty)
+ *  --max-moves <n>            draw the game after n movement-phase moves (default: 300, 0 = no limit)
+ *  --frame-stats <file>       write frame time histograms (CSV) to this file on exit
+ *  --trace <file>             write a Chrome trace of the game loop and AI searches to this file
+ *  --decision-log <file>      append every AI decision to this file as a JSON line
+ *  --node-budgets             limit AI searches by node count (Easy 2k, Medium 20k, Hard 100k) instead of depth
+ * 
+ * @param argc Number of command line arguments
+ * @param argv Array of command line arguments
+ * @return LaunchOptions Options with defaults for anything not given
+ */
+static LaunchOptions parseLaunchOptions(int argc, char* argv[])
+{
+	LaunchOptions options;
+	for (int i = 1; i < argc; ++i) {
+		bool hasValue = i + 1 < argc;
+		if (std::strcmp(argv[i], "--analysis-cache") == 0 && hasValue) {
+			options.analysisCachePath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--analysis-journal") == 0 && hasValue) {
+			options.analysisJournalPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--opening-book") == 0 && hasValue) {
+			options.openingBookPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--piece-atlas") == 0 && hasValue) {
+			options.pieceAtlasPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--variant") == 0 && hasValue) {
+			options.variant = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--max-moves") == 0 && hasValue) {
+			options.maxMoves = std::max(0, std::atoi(argv[++i]));
+		}
+		else if (std::strcmp(argv[i], "--frame-stats") == 0 && hasValue) {
+			options.frameStatsPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--trace") == 0 && hasValue) {
+			options.tracePath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--decision-log") == 0 && hasValue) {
+			options.decisionLogPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--node-budgets") == 0) {
+			options.nodeBudgets = true;
+		}
+		else {
+			std::cout << "Ignoring unknown option " << argv[i] << "\n";
+		}
+	}
+	return options;
+}
 
 /**
  * @brief Entry point for all C++ programs
  * 
  * Creates a Game object and starts the main game loop.
  * This function initializes the game and runs until the player exits.
+ * Tracing starts before the Game is built so asset loading is recorded.
  * 
- * @param argv Array of command line arguments (unused)
+ * @param argc Number of command line arguments
+ * @param argv Array of command line arguments (see parseLaunchOptions)
  * @return int Exit status (0 for successful completion)
  */
-int main(int, char* argv[])
+int main(int argc, char* argv[])
 {
-	Game game;
-	game.run();
+	const LaunchOptions options = parseLaunchOptions(argc, argv);
+	if (!options.tracePath.empty() && !Trace::open(options.tracePath)) {
+		std::cout << "Error opening trace file " << options.tracePath << "\n";
+	}
+	Trace::setThreadName("main");
+
+	{
+		Game game(options);
+		game.run();
+	}
+	Trace::close();
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+/**
+ * @file main.cpp
+ * @brief Piece atlas packer for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * Decodes the five piece images once and writes them as a single atlas pack,
+ * so the game maps the pixels at startup instead of decoding PNGs. Each
+ * image is shrunk to at most 128 pixels a side, so the pack stays small.
+ * The game project depends on this one and runs it after every build, so
+ * the pack follows the images; the game packs the PNGs itself if the pack
+ * is missing.
+ *
+ * Usage: atlas_packer [image directory] [out.t4a]
+ *        (default: ASSETS/IMAGES/ and ASSETS/IMAGES/pieces.t4a)
+ */
+
+#ifdef _DEBUG 
+#pragma comment(lib,"sfml-graphics-d.lib") 
+#pragma comment(lib,"sfml-system-d.lib") 
+#pragma comment(lib,"sfml-window-d.lib") 
+#else 
+#pragma comment(lib,"sfml-graphics.lib") 
+#pragma comment(lib,"sfml-system.lib") 
+#pragma comment(lib,"sfml-window.lib") 
+#endif 
+#pragma comment(lib,"opengl32.lib") 
+
+#include <iostream>
+#include <string>
+#include "PieceAtlas.h"
+
+/**
+ * @brief Entry point for the atlas packer
+ * @param argc Number of command line arguments
+ * @param argv Optional image directory followed by an optional pack path
+ * @return int Exit status (0 on success, 1 on any error)
+ */
+int main(int argc, char* argv[])
+{
+	std::string directory = argc > 1 ? argv[1] : "ASSETS/IMAGES/";
+	const std::string packPath = argc > 2 ? argv[2] : "ASSETS/IMAGES/pieces.t4a";
+	if (!directory.empty() && directory.back() != '/' && directory.back() != '\\') {
+		directory += '/';
+	}
+
+	PieceAtlas atlas;
+	if (!atlas.writePack(directory, packPath)) {
+		std::cout << "Error packing the images in " << directory << " into " << packPath << "\n";
+		return 1;
+	}
+
+	std::cout << "Wrote " << packPath << "\n";
+	for (int type = 0; type < PieceAtlas::TYPE_COUNT; ++type) {
+		const sf::IntRect& rect = atlas.getRect(static_cast<Piece::Type>(type));
+		std::cout << "  type " << type << ": " << rect.size.x << "x" << rect.size.y << " at " << rect.position.x << "," << rect.position.y << "\n";
+	}
+	return 0;
+}
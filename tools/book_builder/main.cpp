@@ -0,0 +1,251 @@
+/**
+ * @file main.cpp
+ * @brief Opening book builder for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * Enumerates every placement-phase position reachable in the first few
+ * plies (one representative per symmetry class), searches each one deeply
+ * with every Strategy on all CPU cores, and writes the results as an
+ * opening book for AI::findBestMove.
+ *
+ * Usage: book_builder <out.t4b> [--plies5 N] [--plies7 N] [--depth D] [--threads T]
+ */
+
+#ifdef _DEBUG 
+#pragma comment(lib,"sfml-graphics-d.lib") 
+#pragma comment(lib,"sfml-system-d.lib") 
+#pragma comment(lib,"sfml-window-d.lib") 
+#else 
+#pragma comment(lib,"sfml-graphics.lib") 
+#pragma comment(lib,"sfml-system.lib") 
+#pragma comment(lib,"sfml-window.lib") 
+#endif 
+#pragma comment(lib,"opengl32.lib") 
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "AI.h"
+#include "OpeningBook.h"
+#include "Variants.h"
+
+/// @brief Number of strategies stored per book position
+static const int STRATEGY_COUNT = 6;
+
+/// @brief A placement position to search, already in canonical orientation
+struct BookPosition {
+	/// @brief Encoded cell occupants (see OpeningBook::encodeCell)
+	std::vector<int> cells;
+	/// @brief Size of the game grid
+	int gridSize;
+	/// @brief True if Player 1 is to move
+	bool isPlayer1ToMove;
+	/// @brief Canonical position hash
+	uint64_t key;
+};
+
+/**
+ * @brief Piece types handed to each player, in piece index order (mirrors Game::setupPieces)
+ * @param gridSize Size of the game grid
+ * @return Piece types for one player
+ */
+static std::vector<Piece::Type> pieceTypesFor(int gridSize)
+{
+	std::vector<Piece::Type> types;
+	const Variant& variant = Variants::get(Variants::findByGridSize(gridSize));
+	for (int i = 0; i < variant.pieceCount; ++i) {
+		types.push_back(Variants::pieceType(i));
+	}
+	return types;
+}
+
+/**
+ * @brief Collects the canonical positions of the first plies of the placement phase
+ * @param gridSize Size of the game grid
+ * @param plies Number of plies to cover (positions with 0 .. plies-1 pieces placed)
+ * @param positions Vector the positions are appended to
+ */
+static void enumeratePositions(int gridSize, int plies, std::vector<BookPosition>& positions)
+{
+	const std::vector<Piece::Type> types = pieceTypesFor(gridSize);
+	const int cellCount = gridSize * gridSize;
+
+	std::vector<BookPosition> frontier;
+	frontier.push_back({ std::vector<int>(cellCount, OpeningBook::EMPTY_CELL), gridSize, true, 0 });
+	int symmetry = 0;
+	frontier.back().key = OpeningBook::canonicalKey(frontier.back().cells, gridSize, true, symmetry);
+
+	for (int ply = 0; ply < plies; ++ply) {
+		positions.insert(positions.end(), frontier.begin(), frontier.end());
+		if (ply + 1 == plies) break;
+
+		std::vector<BookPosition> next;
+		std::unordered_set<uint64_t> seen;
+		for (const auto& position : frontier) {
+			// Each distinct unplaced piece type of the side to move, on each empty cell
+			std::vector<int> unplaced(types.size(), 0);
+			for (auto type : types) unplaced[static_cast<int>(type)]++;
+			for (int cell : position.cells) {
+				if (cell != OpeningBook::EMPTY_CELL && (cell % 2 == 0) == position.isPlayer1ToMove) {
+					unplaced[cell / 2]--;
+				}
+			}
+
+			for (int type = 0; type < static_cast<int>(unplaced.size()); ++type) {
+				if (unplaced[type] <= 0) continue;
+				for (int cell = 0; cell < cellCount; ++cell) {
+					if (position.cells[cell] != OpeningBook::EMPTY_CELL) continue;
+
+					std::vector<int> cells = position.cells;
+					cells[cell] = OpeningBook::encodeCell(position.isPlayer1ToMove, type);
+					bool isPlayer1ToMove = !position.isPlayer1ToMove;
+					uint64_t key = OpeningBook::canonicalKey(cells, gridSize, isPlayer1ToMove, symmetry);
+					if (!seen.insert(key).second) continue;
+
+					// Store the canonical orientation so searched moves are already in book coordinates
+					std::vector<int> canonical(cellCount, OpeningBook::EMPTY_CELL);
+					for (int c = 0; c < cellCount; ++c) {
+						canonical[OpeningBook::transformCell(c, gridSize, symmetry)] = cells[c];
+					}
+					next.push_back({ canonical, gridSize, isPlayer1ToMove, key });
+				}
+			}
+		}
+		frontier.swap(next);
+	}
+}
+
+/**
+ * @brief Searches one position with one strategy
+ * @param ai AI instance owned by the calling thread
+ * @param position Canonical position to search
+ * @param strategy Strategy to search with
+ * @param depth Search depth
+ * @return Book move in canonical coordinates (pieceType -1 if no move was found)
+ */
+static OpeningBookMove searchPosition(AI& ai, const BookPosition& position, Strategy strategy, int depth)
+{
+	const std::vector<Piece::Type> types = pieceTypesFor(position.gridSize);
+	const int gridSize = position.gridSize;
+
+	Position search = {};
+	search.variant = static_cast<int8_t>(Variants::findByGridSize(gridSize));
+	search.gridSize = static_cast<int8_t>(gridSize);
+	search.player1ToMove = position.isPlayer1ToMove;
+	search.placementPhase = true;
+	for (auto& cell : search.cells) cell = Position::NONE;
+	for (int side = 0; side < 2; ++side) {
+		search.pieceCount[side] = static_cast<int8_t>(types.size());
+		for (int i = 0; i < static_cast<int>(types.size()); ++i) {
+			search.pieceTypes[side][i] = static_cast<int8_t>(types[i]);
+			search.pieceCells[side][i] = Position::NONE;
+		}
+	}
+
+	// Occupants are encoded as type * 2 + (Player 1 ? 0 : 1); give each one the first unplaced piece of that type
+	for (int cell = 0; cell < gridSize * gridSize; ++cell) {
+		int occupant = position.cells[cell];
+		if (occupant == OpeningBook::EMPTY_CELL) continue;
+
+		int side = Position::sideOf(occupant % 2 == 0);
+		for (int i = 0; i < search.pieceCount[side]; ++i) {
+			if (search.pieceTypes[side][i] == occupant / 2 && search.pieceCells[side][i] == Position::NONE) {
+				search.putPiece(side, i, cell);
+				break;
+			}
+		}
+	}
+
+	Move move = ai.findBestMove(search, depth, false, Move(), strategy);
+
+	OpeningBookMove result = { -1, -1 };
+	if (move.pieceIndex >= 0) {
+		result.pieceType = search.pieceTypes[search.sideToMove()][move.pieceIndex];
+		result.cell = static_cast<int8_t>(move.toRow * gridSize + move.toCol);
+	}
+	return result;
+}
+
+/**
+ * @brief Entry point for the book builder
+ * @param argc Number of command line arguments
+ * @param argv Output path followed by options
+ * @return int Exit status (0 on success, 1 on any error)
+ */
+int main(int argc, char* argv[])
+{
+	if (argc < 2) {
+		std::cout << "Usage: book_builder <out.t4b> [--plies5 N] [--plies7 N] [--depth D] [--threads T]\n";
+		return 1;
+	}
+
+	const std::string outPath = argv[1];
+	int plies5 = 4;
+	int plies7 = 3;
+	int depth = 4;
+	int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+
+	for (int i = 2; i + 1 < argc; i += 2) {
+		int value = std::atoi(argv[i + 1]);
+		if (std::strcmp(argv[i], "--plies5") == 0) plies5 = value;
+		else if (std::strcmp(argv[i], "--plies7") == 0) plies7 = value;
+		else if (std::strcmp(argv[i], "--depth") == 0) depth = value;
+		else if (std::strcmp(argv[i], "--threads") == 0) threadCount = value;
+		else std::cout << "Ignoring unknown option " << argv[i] << "\n";
+	}
+	if (threadCount < 1) threadCount = 1;
+
+	std::vector<BookPosition> positions;
+	enumeratePositions(5, plies5, positions);
+	enumeratePositions(7, plies7, positions);
+	std::cout << "Searching " << positions.size() << " positions x " << STRATEGY_COUNT
+		<< " strategies at depth " << depth << " on " << threadCount << " threads\n";
+
+	std::vector<OpeningBookRecord> records(positions.size());
+	for (size_t i = 0; i < positions.size(); ++i) {
+		std::memset(&records[i], 0, sizeof(OpeningBookRecord));
+		records[i].key = positions[i].key;
+	}
+
+	// Each job is one (position, strategy) pair; every job writes its own record slot
+	const size_t jobCount = positions.size() * STRATEGY_COUNT;
+	std::atomic<size_t> nextJob{ 0 };
+	std::atomic<size_t> jobsDone{ 0 };
+	std::mutex outputMutex;
+
+	auto worker = [&]() {
+		AI ai;
+		for (size_t job = nextJob++; job < jobCount; job = nextJob++) {
+			size_t positionIndex = job / STRATEGY_COUNT;
+			int strategy = static_cast<int>(job % STRATEGY_COUNT);
+			records[positionIndex].moves[strategy] =
+				searchPosition(ai, positions[positionIndex], static_cast<Strategy>(strategy), depth);
+
+			size_t done = ++jobsDone;
+			if (done % 100 == 0 || done == jobCount) {
+				std::lock_guard<std::mutex> lock(outputMutex);
+				std::cout << "\r" << done << " / " << jobCount << std::flush;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; ++t) threads.emplace_back(worker);
+	for (auto& thread : threads) thread.join();
+	std::cout << "\n";
+
+	if (!OpeningBook::write(outPath, records)) {
+		std::cout << "Error writing " << outPath << "\n";
+		return 1;
+	}
+	std::cout << "Wrote " << records.size() << " book positions to " << outPath << "\n";
+	return 0;
+}
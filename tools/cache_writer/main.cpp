@@ -0,0 +1,76 @@
+/**
+ * @file main.cpp
+ * @brief Analysis cache writer tool for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * Merges AI search journals (written by the game when started with
+ * --analysis-journal) into the memory-mapped analysis cache. For every
+ * position the deepest result is kept; on equal depth the newest wins.
+ *
+ * Usage: cache_writer <cache.t4c> <journal> [journal...]
+ *
+ * The merged cache is written next to the target and then renamed over it,
+ * so games that already have the old cache mapped keep a consistent view
+ * and pick up the new results on their next launch.
+ */
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "AnalysisCache.h"
+
+/**
+ * @brief Entry point for the cache writer
+ * @param argc Number of command line arguments
+ * @param argv Cache path followed by one or more journal paths
+ * @return int Exit status (0 on success, 1 on any error)
+ */
+int main(int argc, char* argv[])
+{
+	if (argc < 3) {
+		std::cout << "Usage: cache_writer <cache.t4c> <journal> [journal...]\n";
+		return 1;
+	}
+
+	const std::string cachePath = argv[1];
+	std::vector<AnalysisRecord> records;
+
+	// Existing results go first so that newer journal entries win ties
+	{
+		AnalysisCache existing;
+		if (existing.open(cachePath)) {
+			records.assign(existing.begin(), existing.end());
+			std::cout << "Loaded " << records.size() << " cached results from " << cachePath << "\n";
+		}
+	}
+
+	for (int i = 2; i < argc; ++i) {
+		size_t before = records.size();
+		if (!AnalysisCache::readJournal(argv[i], records)) {
+			std::cout << "Error reading journal " << argv[i] << "\n";
+			return 1;
+		}
+		std::cout << "Read " << records.size() - before << " results from " << argv[i] << "\n";
+	}
+
+	const std::string tempPath = cachePath + ".new";
+	if (!AnalysisCache::write(tempPath, records)) {
+		std::cout << "Error writing " << tempPath << "\n";
+		return 1;
+	}
+
+	std::remove(cachePath.c_str());
+	if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+		std::cout << "Could not replace " << cachePath << " (is it still open?), merged cache left in " << tempPath << "\n";
+		return 1;
+	}
+
+	AnalysisCache merged;
+	if (merged.open(cachePath)) {
+		std::cout << "Wrote " << merged.size() << " results to " << cachePath << "\n";
+	}
+	return 0;
+}
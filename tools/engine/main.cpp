@@ -0,0 +1,423 @@
+/**
+ * @file main.cpp
+ * @brief Text engine protocol for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * Runs the AI as a headless engine driven by line-oriented commands on
+ * stdin, in the spirit of chess's UCI, so match managers and test rigs can
+ * play engines against each other process to process.
+ *
+ * Commands:
+ *  t4p                                 identify; answers id and option lines, then t4pok
+ *  isready                             answers readyok at once, even while searching
+ *  setoption name <N> value <V>        Strategy, Depth, Threads or Book
+ *  newgame                             forget the current game
+ *  position [startpos] [variant <name>] [moves <move>...]
+ *                                      set up a game from the empty board
+ *  go [depth <d>] [movetime <ms>] [nodes <n>] [infinite]
+ *                                      search, streaming one info line per finished
+ *                                      depth, then answer bestmove <move>; a node
+ *                                      limit alone searches as deep as it allows
+ *  stop                                end the search; bestmove is the deepest finished one
+ *  d                                   print the board
+ *  quit                                exit
+ *
+ * Options:
+ *  --trace <file>                      write a Chrome trace of every search and
+ *                                      iteration to this file
+ *
+ * As in UCI, only isready, stop, d and quit are accepted while a search
+ * runs; setoption, newgame, position and go are refused with an info
+ * string until its bestmove has been sent.
+ *
+ * Moves are written in MoveNotation: a placement such as D@c3 (piece letter
+ * and cell) or a movement such as c3-c4. Scores are from the side to move's
+ * point of view.
+ */
+
+#ifdef _DEBUG
+#pragma comment(lib,"sfml-graphics-d.lib")
+#pragma comment(lib,"sfml-system-d.lib")
+#pragma comment(lib,"sfml-window-d.lib")
+#else
+#pragma comment(lib,"sfml-graphics.lib")
+#pragma comment(lib,"sfml-system.lib")
+#pragma comment(lib,"sfml-window.lib")
+#endif
+#pragma comment(lib,"opengl32.lib")
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AI.h"
+#include "Match.h"
+#include "MoveNotation.h"
+#include "Trace.h"
+#include "Variants.h"
+
+/// @brief Printable names of the strategies, indexed by static_cast<int>(Strategy)
+static const char* const STRATEGY_NAMES[] = { "Balanced", "FavorDiagonal", "FavorCenter", "FavorEdges", "Aggressive", "Defensive" };
+/// @brief Number of strategies
+static const int STRATEGY_COUNT = 6;
+/// @brief Deepest search "go infinite" will run to
+static const int MAX_SEARCH_DEPTH = 64;
+
+/// @brief Limits of one "go" command
+struct SearchLimits {
+	/// @brief Deepest iteration to search
+	int depth;
+	/// @brief Time after which the search is stopped, in milliseconds (0 for no limit)
+	int moveTime;
+	/// @brief Nodes after which the search is stopped (0 for no limit); unlike time, the same on every machine
+	uint64_t nodes;
+};
+
+/**
+ * @brief Headless engine: the current game, the options and the search thread
+ *
+ * Commands are read on the main thread; "go" starts the search on its own
+ * thread so that "stop" and "isready" are answered while it runs. The main
+ * thread never waits on a running search, which may have no end. Output
+ * from both threads goes through send, which keeps lines whole.
+ */
+class EngineSession
+{
+public:
+	/// @brief Constructor, starting a 5x5 game
+	EngineSession() {}
+
+	/// @brief Destructor, stopping any search in progress
+	~EngineSession() { stopSearch(); }
+
+	/// @brief Handle one command line
+	/// @param line Command as read from stdin
+	/// @return False once the engine should exit
+	bool handle(const std::string& line)
+	{
+		std::istringstream tokens(line);
+		std::string command;
+		if (!(tokens >> command)) return true;
+
+		if (command == "t4p") {
+			send("id name The Fourth Protocol");
+			send("id author RCH and OA-O");
+			send("option name Strategy type combo default Balanced var Balanced var FavorDiagonal var FavorCenter var FavorEdges var Aggressive var Defensive");
+			send("option name Depth type spin default 3 min 1 max " + std::to_string(MAX_SEARCH_DEPTH));
+			send("option name Threads type spin default 1 min 1 max 1");
+			send("option name Book type string default <empty>");
+			send("t4pok");
+		}
+		else if (command == "isready") {
+			send("readyok");
+		}
+		else if (command == "setoption") {
+			if (finishSearch(command)) setOption(tokens);
+		}
+		else if (command == "newgame") {
+			if (finishSearch(command)) m_match = Match(m_match.getPosition().variant);
+		}
+		else if (command == "position") {
+			if (finishSearch(command)) setPosition(tokens);
+		}
+		else if (command == "go") {
+			if (finishSearch(command)) go(tokens);
+		}
+		else if (command == "stop") {
+			stopSearch();
+		}
+		else if (command == "d") {
+			// The search only reads the game, so the board can be printed while it runs
+			printBoard();
+		}
+		else if (command == "quit") {
+			return false;
+		}
+		else {
+			send("info string unknown command " + command);
+		}
+		return true;
+	}
+
+private:
+	/// @brief Write one line to stdout
+	/// @param line Line without its newline
+	void send(const std::string& line)
+	{
+		std::lock_guard<std::mutex> lock(m_outputMutex);
+		std::cout << line << std::endl;
+	}
+
+	/// @brief Handle "setoption name <N> value <V>"
+	/// @param tokens Rest of the command line
+	void setOption(std::istringstream& tokens)
+	{
+		std::string word, name, value;
+		tokens >> word >> name >> word;
+		std::getline(tokens >> std::ws, value);
+
+		if (name == "Strategy") {
+			for (int i = 0; i < STRATEGY_COUNT; ++i) {
+				if (value == STRATEGY_NAMES[i]) m_strategy = static_cast<Strategy>(i);
+			}
+		}
+		else if (name == "Depth") {
+			m_depth = std::min(std::max(std::atoi(value.c_str()), 1), MAX_SEARCH_DEPTH);
+		}
+		else if (name == "Threads") {
+			// The search is single-threaded; accepted so managers that always send it keep working
+			if (std::atoi(value.c_str()) != 1) send("info string Threads is fixed at 1");
+		}
+		else if (name == "Book") {
+			if (!m_ai.openOpeningBook(value)) send("info string could not open book " + value);
+		}
+		else {
+			send("info string unknown option " + name);
+		}
+	}
+
+	/// @brief Handle "position [startpos] [variant <name>] [moves ...]"
+	/// @param tokens Rest of the command line
+	void setPosition(std::istringstream& tokens)
+	{
+		int variant = m_match.getPosition().variant;
+		std::string word;
+		std::vector<std::string> moves;
+		bool readingMoves = false;
+		while (tokens >> word) {
+			if (readingMoves) {
+				moves.push_back(word);
+			}
+			else if (word == "variant" && tokens >> word) {
+				variant = Variants::find(word);
+				if (variant < 0) {
+					send("info string unknown variant " + word);
+					variant = m_match.getPosition().variant;
+				}
+			}
+			else if (word == "moves") {
+				readingMoves = true;
+			}
+		}
+
+		m_match = Match(variant);
+		for (const auto& text : moves) {
+			Move move;
+			if (!MoveNotation::parse(m_match.getPosition(), text, move) || !m_match.play(move)) {
+				send("info string illegal move " + text);
+				break;
+			}
+		}
+	}
+
+	/// @brief Handle "go [depth <d>] [movetime <ms>] [nodes <n>] [infinite]" by starting the search thread
+	/// @param tokens Rest of the command line
+	void go(std::istringstream& tokens)
+	{
+		SearchLimits limits = { m_depth, 0, 0 };
+		bool hasDepth = false;
+		std::string word;
+		while (tokens >> word) {
+			if (word == "depth" && tokens >> limits.depth) {
+				limits.depth = std::min(std::max(limits.depth, 1), MAX_SEARCH_DEPTH);
+				hasDepth = true;
+			}
+			else if (word == "movetime") tokens >> limits.moveTime;
+			else if (word == "nodes") tokens >> limits.nodes;
+			else if (word == "infinite") limits.depth = MAX_SEARCH_DEPTH;
+		}
+		if (limits.nodes > 0 && !hasDepth) limits.depth = MAX_SEARCH_DEPTH;
+
+		m_stop = false;
+		m_searchDone = false;
+		m_ai.setStopFlag(&m_stop);
+		m_searchThread = std::thread(&EngineSession::search, this, limits);
+		if (limits.moveTime > 0) {
+			m_timerThread = std::thread([this, limits]() {
+				std::unique_lock<std::mutex> lock(m_timerMutex);
+				if (!m_timerCondition.wait_for(lock, std::chrono::milliseconds(limits.moveTime), [this]() { return m_searchDone; })) {
+					m_stop = true;
+				}
+			});
+		}
+	}
+
+	/// @brief Iteratively deepen until the depth limit or a stop, then answer bestmove
+	/// @param limits Limits of the "go" command
+	void search(SearchLimits limits)
+	{
+		Trace::setThreadName("search");
+		Trace::Zone zone("search");
+		const auto start = std::chrono::steady_clock::now();
+		Move bestMove;
+		uint64_t nodes = 0;
+
+		const Position& position = m_match.getPosition();
+		const Move& lastMove = m_match.getLastMove(position.sideToMove());
+		for (int depth = 1; depth <= limits.depth && !m_match.isOver(); ++depth) {
+			if (limits.nodes > 0) {
+				if (nodes >= limits.nodes) break;
+				m_ai.setNodeLimit(limits.nodes - nodes);
+			}
+			Trace::Zone iterationZone("iteration", "depth", depth);
+			Move move = m_ai.findBestMove(position, depth, false, lastMove, m_strategy, m_match.getHistory());
+			nodes += m_ai.getNodesSearched();
+			if (m_ai.wasStopped() || move.pieceIndex < 0) break;
+			bestMove = move;
+
+			const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+			std::ostringstream info;
+			info << "info depth " << depth << " score " << m_ai.getBestScore() << " nodes " << nodes
+				<< " nps " << (elapsed > 0 ? nodes * 1000 / elapsed : nodes) << " time " << elapsed
+				<< " pv";
+
+			// Replay the line so each move is written from the position it is played in
+			const SearchStats& stats = m_ai.getSearchStats();
+			Match line = m_match;
+			for (int i = 0; i < stats.principalVariationLength; ++i) {
+				const std::string text = MoveNotation::format(line.getPosition(), stats.principalVariation[i]);
+				if (!line.play(stats.principalVariation[i])) break;
+				info << ' ' << text;
+			}
+			send(info.str());
+
+			// Book moves do not depend on the depth, so deeper iterations would only repeat them
+			if (m_ai.wasLastMoveFromBook()) break;
+		}
+
+		m_ai.setNodeLimit(0);
+
+		// Stopping before depth 1 finished still has to answer with a legal move
+		if (bestMove.pieceIndex < 0 && !m_match.isOver() && m_ai.wasStopped()) {
+			m_ai.setStopFlag(nullptr);
+			bestMove = m_ai.findBestMove(position, 1, false, lastMove, m_strategy, m_match.getHistory());
+		}
+		m_ai.journalLastDecision();
+		const std::string answer = "bestmove " + (bestMove.pieceIndex >= 0 ? MoveNotation::format(position, bestMove) : std::string("(none)"));
+
+		// Marked done before bestmove goes out, so a command sent in reply to it is never refused
+		{
+			std::lock_guard<std::mutex> lock(m_timerMutex);
+			m_searchDone = true;
+			m_timerCondition.notify_all();
+		}
+		send(answer);
+	}
+
+	/// @brief Join a search that has sent its bestmove, or refuse a command while one is still running
+	/// @param command Command that needs the engine idle
+	/// @return True if no search is running any more
+	bool finishSearch(const std::string& command)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_timerMutex);
+			if (!m_searchDone) {
+				send("info string " + command + " ignored while searching, send stop first");
+				return false;
+			}
+		}
+		waitForSearch();
+		return true;
+	}
+
+	/// @brief Wait for the search thread (and its timer) to finish
+	void waitForSearch()
+	{
+		if (m_searchThread.joinable()) m_searchThread.join();
+		if (m_timerThread.joinable()) m_timerThread.join();
+	}
+
+	/// @brief Stop the search in progress and wait for its bestmove
+	void stopSearch()
+	{
+		m_stop = true;
+		waitForSearch();
+	}
+
+	/// @brief Print the board for "d", Player 1's pieces in upper case
+	void printBoard()
+	{
+		const Position& position = m_match.getPosition();
+		const int gridSize = position.gridSize;
+		for (int row = 0; row < gridSize; ++row) {
+			std::string line = "info string ";
+			for (int col = 0; col < gridSize; ++col) {
+				const int cell = row * gridSize + col;
+				char symbol = '.';
+				if (!position.isEmpty(cell)) {
+					symbol = MoveNotation::pieceLetter(position.typeAt(cell));
+					if (!position.isPlayer1At(cell)) symbol = static_cast<char>(std::tolower(symbol));
+				}
+				line += symbol;
+			}
+			send(line);
+		}
+		send(std::string("info string ") + (position.player1ToMove ? "Player 1" : "Player 2") + " to "
+			+ (position.placementPhase ? "place" : "move") + (m_match.isOver() ? ", game over" : ""));
+	}
+
+	/// @brief AI doing the searching
+	AI m_ai;
+	/// @brief Game set up by the last position command
+	Match m_match;
+	/// @brief Strategy set with setoption
+	Strategy m_strategy = Strategy::Balanced;
+	/// @brief Default search depth set with setoption
+	int m_depth = 3;
+
+	/// @brief Thread running the current search
+	std::thread m_searchThread;
+	/// @brief Thread stopping the search when its movetime runs out
+	std::thread m_timerThread;
+	/// @brief Set to stop the search
+	std::atomic<bool> m_stop{ false };
+	/// @brief Guards m_searchDone for the timer
+	std::mutex m_timerMutex;
+	/// @brief Wakes the timer when the search finishes first
+	std::condition_variable m_timerCondition;
+	/// @brief True once the search thread has sent bestmove
+	bool m_searchDone = true;
+	/// @brief Keeps lines from the two threads whole
+	std::mutex m_outputMutex;
+};
+
+/**
+ * @brief Entry point for the engine
+ * @param argc Number of command line arguments
+ * @param argv Array of command line arguments (see the options above)
+ * @return int Exit status (always 0)
+ */
+int main(int argc, char* argv[])
+{
+	// stdout belongs to the protocol, so option errors go to stderr
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+			const char* path = argv[++i];
+			if (!Trace::open(path)) std::cerr << "Error opening trace file " << path << "\n";
+		}
+		else {
+			std::cerr << "Ignoring unknown option " << argv[i] << "\n";
+		}
+	}
+	Trace::setThreadName("protocol");
+
+	{
+		EngineSession session;
+		std::string line;
+		while (std::getline(std::cin, line) && session.handle(line)) {
+		}
+	}
+	Trace::close();
+	return 0;
+}
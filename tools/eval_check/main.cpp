@@ -0,0 +1,180 @@
+/**
+ * @file main.cpp
+ * @brief Evaluation kernel check for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * Scores random boards of every variant with every strategy through each
+ * evaluation path the AI can take (line patterns, long-line walk, wide
+ * bitboards and each SIMD kernel this CPU supports) and compares them with
+ * a frozen copy of the original per-piece countInLine evaluation. Any
+ * difference means a kernel no longer plays the game the AI was tuned on,
+ * so the check exits non-zero and can gate a build or CI run.
+ *
+ * Usage: eval_check [boards per strategy and variant]   (default 2000)
+ */
+
+#ifdef _DEBUG
+#pragma comment(lib,"sfml-graphics-d.lib")
+#pragma comment(lib,"sfml-system-d.lib")
+#pragma comment(lib,"sfml-window-d.lib")
+#else
+#pragma comment(lib,"sfml-graphics.lib")
+#pragma comment(lib,"sfml-system.lib")
+#pragma comment(lib,"sfml-window.lib")
+#endif
+#pragma comment(lib,"opengl32.lib")
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include "AI.h"
+
+namespace {
+	// The functions below are the evaluation the AI shipped with, kept as it
+	//  was apart from reading a Position instead of a Piece* grid. Do not
+	//  optimise them: they are what every faster path is measured against.
+
+	/// @brief Score a cell by its closeness to the centre (0-10)
+	int referenceScoreCloserToCenter(int row, int col, int gridSize)
+	{
+		float centerRow = (gridSize - 1) / 2.0f;
+		float centerCol = (gridSize - 1) / 2.0f;
+		float distanceFromCenter = std::abs(row - centerRow) + std::abs(col - centerCol);
+		float maxDistance = centerRow + centerCol;
+		return static_cast<int>((1.0f - (distanceFromCenter / maxDistance)) * 10.0f);
+	}
+
+	/// @brief Count a player's pieces in a row through a cell along one direction, the cell included
+	int referenceCountInLine(const Position& position, int row, int col, int dRow, int dCol, bool isPlayer1)
+	{
+		int count = 1;
+		int gridSize = position.gridSize;
+
+		int r = row + dRow;
+		int c = col + dCol;
+		while (r >= 0 && r < gridSize && c >= 0 && c < gridSize && !position.isEmpty(r * gridSize + c)
+			&& position.isPlayer1At(r * gridSize + c) == isPlayer1) {
+			count++;
+			r += dRow;
+			c += dCol;
+		}
+
+		r = row - dRow;
+		c = col - dCol;
+		while (r >= 0 && r < gridSize && c >= 0 && c < gridSize && !position.isEmpty(r * gridSize + c)
+			&& position.isPlayer1At(r * gridSize + c) == isPlayer1) {
+			count++;
+			r -= dRow;
+			c -= dCol;
+		}
+
+		return count;
+	}
+
+	/// @brief Score a position the way the original AI::evaluateBoard did
+	/// @param position Position to score
+	/// @param strategy Evaluation strategy
+	/// @return Score from Player 2's point of view
+	int referenceEvaluate(const Position& position, Strategy strategy)
+	{
+		int score = 0;
+		int gridSize = position.gridSize;
+		bool isPlacementPhase = position.placementPhase;
+
+		int centerMultiplier = 1;
+		int edgeMultiplier = 0;
+		int horizontalMultiplier = 10;
+		int verticalMultiplier = 10;
+		int diagonalMultiplier = 10;
+		int offenseMultiplier = 1;
+		int defenseMultiplier = 1;
+
+		switch (strategy) {
+			case Strategy::FavorCenter:
+				centerMultiplier = isPlacementPhase ? 8 : 3;
+				break;
+			case Strategy::FavorEdges:
+				centerMultiplier = 0;
+				edgeMultiplier = isPlacementPhase ? 8 : 2;
+				break;
+			case Strategy::FavorDiagonal:
+				diagonalMultiplier = 20;
+				horizontalMultiplier = 8;
+				verticalMultiplier = 8;
+				break;
+			case Strategy::Aggressive:
+				offenseMultiplier = 2;
+				defenseMultiplier = 1;
+				centerMultiplier = isPlacementPhase ? 3 : 1;
+				break;
+			case Strategy::Defensive:
+				offenseMultiplier = 1;
+				defenseMultiplier = 2;
+				centerMultiplier = isPlacementPhase ? 2 : 1;
+				break;
+			case Strategy::Balanced:
+			default:
+				centerMultiplier = isPlacementPhase ? 3 : 1;
+				break;
+		}
+
+		const int directions[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+		const int lineMultipliers[4] = { horizontalMultiplier, verticalMultiplier, diagonalMultiplier, diagonalMultiplier };
+
+		for (int row = 0; row < gridSize; ++row) {
+			for (int col = 0; col < gridSize; ++col) {
+				if (position.isEmpty(row * gridSize + col)) continue;
+
+				bool isEdge = (row == 0 || row == gridSize - 1 || col == 0 || col == gridSize - 1);
+				bool isPlayer1 = position.isPlayer1At(row * gridSize + col);
+				int positional = referenceScoreCloserToCenter(row, col, gridSize) * centerMultiplier + (isEdge ? 5 * edgeMultiplier : 0);
+				score += isPlayer1 ? -positional : positional;
+
+				for (int d = 0; d < 4; ++d) {
+					int lineCount = referenceCountInLine(position, row, col, directions[d][0], directions[d][1], isPlayer1);
+					if (!isPlayer1) {
+						if (lineCount >= 3) score += lineCount * lineCount * lineMultipliers[d] * 15 / 10 * offenseMultiplier;
+						else score += lineCount * lineCount * lineMultipliers[d] * offenseMultiplier;
+					}
+					else {
+						if (lineCount >= 3) score -= lineCount * lineCount * lineMultipliers[d] * 2 * defenseMultiplier;
+						else score -= lineCount * lineCount * lineMultipliers[d] * defenseMultiplier;
+					}
+				}
+			}
+		}
+
+		return score;
+	}
+}
+
+/**
+ * @brief Entry point for the evaluation check
+ * @param argc Number of command line arguments
+ * @param argv Optional number of random boards per strategy and variant
+ * @return int Exit status (0 if every evaluation path matched, 1 otherwise)
+ */
+int main(int argc, char* argv[])
+{
+	const int positions = argc > 1 ? std::atoi(argv[1]) : 2000;
+	if (positions <= 0) {
+		std::cout << "Usage: eval_check [boards per strategy and variant]\n";
+		return 1;
+	}
+
+	AI ai;
+	std::cout << "Evaluation kernel: " << BitboardEvaluator::kernelName(ai.getEvaluationKernel()) << "\n";
+	for (auto kernel : { BitboardEvaluator::Kernel::Scalar, BitboardEvaluator::Kernel::SSE41, BitboardEvaluator::Kernel::AVX2 }) {
+		std::cout << "  " << BitboardEvaluator::kernelName(kernel) << (BitboardEvaluator::isSupported(kernel) ? " checked" : " not supported") << "\n";
+	}
+
+	const int mismatches = ai.verifyEvaluationKernels(referenceEvaluate, positions);
+	if (mismatches > 0) {
+		std::cout << "Error: " << mismatches << " evaluations disagree with the reference evaluation\n";
+		return 1;
+	}
+	std::cout << "Every evaluation path matches the reference on " << positions << " boards per strategy and variant\n";
+	return 0;
+}
@@ -0,0 +1,751 @@
+/**
+ * @file main.cpp
+ * @brief Headless multi-session game server for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * Hosts many independent games (player vs player and player vs AI) in one
+ * process over a localhost TCP socket. Clients send one command per line
+ * and may take part in any number of sessions at once; every move is
+ * refereed by Match, so the server applies exactly the rules of the game.
+ *
+ * The network thread owns every session. AI turns are queued for a fixed
+ * pool of worker threads, each with its own AI. The queue is fair: the
+ * session that has used the least AI time so far is served first, and every
+ * search is stopped once it reaches the per-move time budget (the deepest
+ * finished iteration is played), so one deep search cannot hold back the
+ * other sessions.
+ *
+ * Sockets are non-blocking. Answers are queued per client and written out
+ * as the socket takes them, so a client that stops reading only fills its
+ * own queue (and is dropped once that grows too long) instead of stalling
+ * every other session behind a blocked send.
+ *
+ * Usage: game_server [--port N] [--workers N] [--move-time MS] [--max-moves N]
+ *
+ * Commands (answers in brackets):
+ *  new <variant> pvp                   open a game as Player 1 [created <id> 1]
+ *  new <variant> ai <strategy> [easy|medium|hard]
+ *                                      play Player 1 against the AI [created <id> 1]
+ *  list                                games waiting for a player [open <id> <variant>... end]
+ *  join <id>                           take Player 2 [joined <id> 2; the host gets opponent <id>]
+ *  move <id> <move>                    play a move in MoveNotation [moved <id> <move> to both players]
+ *  state <id>                          [state <id> <variant> <p1|p2> <place|move> <cells>]
+ *  leave <id>                          leave a game [left <id>; the other player gets over <id> abandoned]
+ *  bye                                 close the connection
+ *
+ * A finished game sends over <id> <player1|player2|draw> and is closed.
+ * Mistakes are answered with error <id> <reason> (id 0 if there is none).
+ * If the referee ever rejects the AI's own move, the players get
+ * error <id> server rejected the AI move, then over <id> abandoned.
+ */
+
+#ifdef _DEBUG
+#pragma comment(lib,"sfml-graphics-d.lib")
+#pragma comment(lib,"sfml-network-d.lib")
+#pragma comment(lib,"sfml-system-d.lib")
+#pragma comment(lib,"sfml-window-d.lib")
+#else
+#pragma comment(lib,"sfml-graphics.lib")
+#pragma comment(lib,"sfml-network.lib")
+#pragma comment(lib,"sfml-system.lib")
+#pragma comment(lib,"sfml-window.lib")
+#endif
+#pragma comment(lib,"opengl32.lib")
+
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "AI.h"
+#include "Match.h"
+#include "MoveNotation.h"
+#include "Variants.h"
+
+/// @brief Printable names of the strategies, indexed by static_cast<int>(Strategy)
+static const char* const STRATEGY_NAMES[] = { "Balanced", "FavorDiagonal", "FavorCenter", "FavorEdges", "Aggressive", "Defensive" };
+/// @brief Number of strategies
+static const int STRATEGY_COUNT = 6;
+/// @brief Longest command line accepted from a client
+static const size_t MAX_LINE_LENGTH = 256;
+/// @brief Most output queued for a client before it is taken to have stopped reading and is dropped
+static const size_t MAX_OUTPUT_LENGTH = 64 * 1024;
+
+/// @brief Options read from the command line
+struct ServerSettings {
+	/// @brief TCP port to listen on (localhost only)
+	unsigned short port = 5150;
+	/// @brief Number of AI worker threads
+	int workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	/// @brief Time budget of one AI move, in milliseconds
+	int moveTime = 1000;
+	/// @brief Movement-phase moves after which a game is drawn (0 for no limit)
+	int maxMoves = 300;
+};
+
+/// @brief AI turn waiting for a worker
+struct AIJob {
+	/// @brief Session the move is for
+	int sessionId;
+	/// @brief AI time the session had used when the job was queued (lower is served first)
+	uint64_t usedMicros;
+	/// @brief Queue order among jobs with the same usedMicros
+	uint64_t sequence;
+	/// @brief Position to search
+	Position position;
+	/// @brief Movement-phase positions of the game, for repetition draws
+	PositionHistory history;
+	/// @brief AI's previous move (the search avoids undoing it)
+	Move lastMove;
+	/// @brief Evaluation strategy
+	Strategy strategy;
+	/// @brief Deepest iteration to search
+	int depth;
+};
+
+/// @brief Orders the job queue so the session with the least AI time comes first
+struct AIJobOrder {
+	/// @brief Check if a job should be served after another
+	/// @param a Job to compare
+	/// @param b Other job
+	/// @return True if a comes after b
+	bool operator()(const AIJob& a, const AIJob& b) const
+	{
+		return a.usedMicros != b.usedMicros ? a.usedMicros > b.usedMicros : a.sequence > b.sequence;
+	}
+};
+
+/// @brief Move found by a worker
+struct AIResult {
+	/// @brief Session the move is for
+	int sessionId;
+	/// @brief Move found (pieceIndex -1 if the AI has none)
+	Move move;
+	/// @brief Time the search took, in microseconds
+	uint64_t micros;
+};
+
+/**
+ * @brief Fixed pool of AI workers with a fair queue and per-move time budgets
+ *
+ * Jobs are taken in order of their session's AI time so far. Each worker
+ * searches iteratively deeper until its depth limit or its deadline; a
+ * timekeeper thread raises the stop flag of any worker past its deadline.
+ */
+class AIWorkerPool
+{
+public:
+	/// @brief Start the workers and the timekeeper
+	/// @param workerCount Number of worker threads
+	/// @param moveTime Time budget of one move, in milliseconds
+	AIWorkerPool(int workerCount, int moveTime)
+		: m_workers(workerCount), m_moveTime(moveTime)
+	{
+		for (int i = 0; i < workerCount; ++i) {
+			m_workers[i].thread = std::thread(&AIWorkerPool::work, this, i);
+		}
+		m_timekeeper = std::thread(&AIWorkerPool::keepTime, this);
+	}
+
+	/// @brief Stop every search and join the threads
+	~AIWorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_jobMutex);
+			m_shuttingDown = true;
+			for (auto& worker : m_workers) worker.stop = true;
+		}
+		m_jobAvailable.notify_all();
+		for (auto& worker : m_workers) worker.thread.join();
+		m_timekeeper.join();
+	}
+
+	/// @brief Queue an AI turn
+	/// @param job Turn to search (sequence is filled in here)
+	void submit(AIJob job)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_jobMutex);
+			job.sequence = m_nextSequence++;
+			m_jobs.push(std::move(job));
+		}
+		m_jobAvailable.notify_one();
+	}
+
+	/// @brief Collect the moves finished since the last call
+	/// @param results Vector the results are appended to
+	void takeResults(std::vector<AIResult>& results)
+	{
+		std::lock_guard<std::mutex> lock(m_resultMutex);
+		results.insert(results.end(), m_results.begin(), m_results.end());
+		m_results.clear();
+	}
+
+private:
+	/// @brief One worker thread and its search state
+	struct Worker {
+		/// @brief The thread
+		std::thread thread;
+		/// @brief Stop flag handed to the worker's AI
+		std::atomic<bool> stop{ false };
+		/// @brief Deadline of the current search in steady-clock ticks (0 when idle)
+		std::atomic<int64_t> deadline{ 0 };
+	};
+
+	/// @brief Worker loop: take the fairest job, search it, post the move
+	/// @param index Index of the worker
+	void work(int index)
+	{
+		Worker& worker = m_workers[index];
+		AI ai;
+		ai.setStopFlag(&worker.stop);
+
+		for (;;) {
+			AIJob job;
+			{
+				std::unique_lock<std::mutex> lock(m_jobMutex);
+				m_jobAvailable.wait(lock, [this]() { return m_shuttingDown || !m_jobs.empty(); });
+				if (m_shuttingDown) return;
+				job = m_jobs.top();
+				m_jobs.pop();
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+			worker.stop = false;
+			worker.deadline = (start + std::chrono::milliseconds(m_moveTime)).time_since_epoch().count();
+
+			Move bestMove;
+			for (int depth = 1; depth <= job.depth; ++depth) {
+				Move move = ai.findBestMove(job.position, depth, false, job.lastMove, job.strategy, job.history);
+				if (ai.wasStopped() || move.pieceIndex < 0) break;
+				bestMove = move;
+				if (ai.wasLastMoveFromBook()) break;
+			}
+			worker.deadline = 0;
+
+			// Even the first iteration ran out of time: finish it rather than forfeit the move
+			if (bestMove.pieceIndex < 0 && ai.wasStopped()) {
+				if (m_shuttingDown) return;
+				worker.stop = false;
+				bestMove = ai.findBestMove(job.position, 1, false, job.lastMove, job.strategy, job.history);
+			}
+			ai.journalLastDecision();
+
+			const auto elapsed = std::chrono::steady_clock::now() - start;
+			std::lock_guard<std::mutex> lock(m_resultMutex);
+			m_results.push_back({ job.sessionId, bestMove,
+				static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) });
+		}
+	}
+
+	/// @brief Timekeeper loop: stop every search that is past its deadline
+	void keepTime()
+	{
+		while (!m_shuttingDown) {
+			const int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+			for (auto& worker : m_workers) {
+				const int64_t deadline = worker.deadline;
+				if (deadline != 0 && now >= deadline) worker.stop = true;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+	}
+
+	/// @brief Worker threads (a deque never moves its elements, so the atomics stay put)
+	std::deque<Worker> m_workers;
+	/// @brief Thread enforcing the deadlines
+	std::thread m_timekeeper;
+	/// @brief Time budget of one move, in milliseconds
+	int m_moveTime;
+
+	/// @brief Guards m_jobs and m_nextSequence
+	std::mutex m_jobMutex;
+	/// @brief Wakes a worker when a job is queued
+	std::condition_variable m_jobAvailable;
+	/// @brief Queued AI turns, fairest first
+	std::priority_queue<AIJob, std::vector<AIJob>, AIJobOrder> m_jobs;
+	/// @brief Sequence number of the next job
+	uint64_t m_nextSequence = 0;
+	/// @brief True once the pool is being destroyed
+	std::atomic<bool> m_shuttingDown{ false };
+
+	/// @brief Guards m_results
+	std::mutex m_resultMutex;
+	/// @brief Moves waiting for the network thread
+	std::vector<AIResult> m_results;
+};
+
+/// @brief One hosted game
+struct Session {
+	/// @brief Game state and referee
+	Match match;
+	/// @brief Client playing each side, [Player 1, Player 2] (-1 for the AI or an empty seat)
+	int players[2] = { -1, -1 };
+	/// @brief True if Player 2 is the AI
+	bool isAIGame = false;
+	/// @brief AI strategy
+	Strategy strategy = Strategy::Balanced;
+	/// @brief AI search depth
+	int depth = 3;
+	/// @brief True while an AI turn is queued or being searched
+	bool aiThinking = false;
+	/// @brief AI time used by this session so far, in microseconds
+	uint64_t usedMicros = 0;
+};
+
+/// @brief One connected client
+struct Client {
+	/// @brief Connection to the client
+	std::unique_ptr<sf::TcpSocket> socket;
+	/// @brief Bytes received after the last complete line
+	std::string pending;
+	/// @brief Bytes queued for the client that its socket has not taken yet
+	std::string output;
+	/// @brief Sessions the client is playing in
+	std::vector<int> sessions;
+};
+
+/**
+ * @brief Network side of the server: connections, sessions and command handling
+ *
+ * Everything here runs on the network thread; the worker pool only ever
+ * sees copies of positions, and its moves are applied back here.
+ */
+class GameServer
+{
+public:
+	/// @brief Constructor
+	/// @param settings Server options
+	explicit GameServer(const ServerSettings& settings)
+		: m_settings(settings), m_pool(settings.workers, settings.moveTime) {}
+
+	/// @brief Listen and serve clients until the process is stopped
+	/// @return False if the port could not be opened
+	bool run()
+	{
+		if (m_listener.listen(m_settings.port, sf::IpAddress::LocalHost) != sf::Socket::Status::Done) {
+			std::cout << "Could not listen on port " << m_settings.port << "\n";
+			return false;
+		}
+		m_selector.add(m_listener);
+		std::cout << "Serving on localhost:" << m_settings.port << " with " << m_settings.workers
+			<< " AI workers, " << m_settings.moveTime << " ms per AI move\n";
+
+		std::vector<AIResult> results;
+		for (;;) {
+			// A short timeout keeps AI moves flowing out while no client is talking
+			if (m_selector.wait(sf::milliseconds(5))) {
+				if (m_selector.isReady(m_listener)) acceptClient();
+				std::vector<int> ready;
+				for (auto& entry : m_clients) {
+					if (m_selector.isReady(*entry.second.socket)) ready.push_back(entry.first);
+				}
+				for (int clientId : ready) receive(clientId);
+			}
+
+			results.clear();
+			m_pool.takeResults(results);
+			for (const auto& result : results) applyAIMove(result);
+
+			// SocketSelector only reports readable sockets, so queued output is offered every pass
+			flushOutput();
+		}
+	}
+
+private:
+	/// @brief Accept a waiting connection
+	void acceptClient()
+	{
+		std::unique_ptr<sf::TcpSocket> socket(new sf::TcpSocket());
+		if (m_listener.accept(*socket) != sf::Socket::Status::Done) return;
+		socket->setBlocking(false);
+		m_selector.add(*socket);
+		const int clientId = m_nextClientId++;
+		m_clients[clientId].socket = std::move(socket);
+	}
+
+	/// @brief Read from a client and handle every complete line
+	/// @param clientId Client with data waiting
+	void receive(int clientId)
+	{
+		char buffer[1024];
+		std::size_t received = 0;
+		Client& client = m_clients[clientId];
+		const sf::Socket::Status status = client.socket->receive(buffer, sizeof(buffer), received);
+		if (status == sf::Socket::Status::NotReady) return;
+		if (status != sf::Socket::Status::Done) {
+			disconnect(clientId);
+			return;
+		}
+
+		client.pending.append(buffer, received);
+		size_t newline;
+		while ((newline = m_clients[clientId].pending.find('\n')) != std::string::npos) {
+			std::string line = m_clients[clientId].pending.substr(0, newline);
+			m_clients[clientId].pending.erase(0, newline + 1);
+			if (!line.empty() && line.back() == '\r') line.pop_back();
+			if (!handle(clientId, line)) {
+				disconnect(clientId);
+				return;
+			}
+		}
+		if (m_clients[clientId].pending.size() > MAX_LINE_LENGTH) {
+			send(clientId, "error 0 line too long");
+			disconnect(clientId);
+		}
+	}
+
+	/// @brief Drop a client, abandoning its games
+	/// @param clientId Client to drop
+	void disconnect(int clientId)
+	{
+		auto found = m_clients.find(clientId);
+		if (found == m_clients.end()) return;
+
+		const std::vector<int> sessions = found->second.sessions;
+		for (int sessionId : sessions) leaveSession(clientId, sessionId);
+
+		// Last chance for a parting answer such as "line too long"; whatever the socket refuses is lost
+		Client& client = found->second;
+		std::size_t sent = 0;
+		if (!client.output.empty()) client.socket->send(client.output.data(), client.output.size(), sent);
+		m_selector.remove(*client.socket);
+		m_clients.erase(found);
+	}
+
+	/// @brief Queue one line for a client
+	/// @param clientId Receiving client (ignored if gone)
+	/// @param line Line without its newline
+	void send(int clientId, const std::string& line)
+	{
+		auto found = m_clients.find(clientId);
+		if (found == m_clients.end()) return;
+		found->second.output += line;
+		found->second.output += '\n';
+	}
+
+	/// @brief Write as much queued output as each socket takes without blocking, dropping clients that stopped reading
+	void flushOutput()
+	{
+		std::vector<int> dropped;
+		for (auto& entry : m_clients) {
+			Client& client = entry.second;
+			if (client.output.empty()) continue;
+
+			std::size_t sent = 0;
+			const sf::Socket::Status status = client.socket->send(client.output.data(), client.output.size(), sent);
+			client.output.erase(0, sent);
+			if (status == sf::Socket::Status::Disconnected || status == sf::Socket::Status::Error
+				|| client.output.size() > MAX_OUTPUT_LENGTH) {
+				dropped.push_back(entry.first);
+			}
+		}
+		for (int clientId : dropped) {
+			m_clients[clientId].output.clear();
+			disconnect(clientId);
+		}
+	}
+
+	/// @brief Send one line to every client playing in a session
+	/// @param session Session whose players are told
+	/// @param line Line without its newline
+	void broadcast(const Session& session, const std::string& line)
+	{
+		send(session.players[0], line);
+		if (session.players[1] != session.players[0]) send(session.players[1], line);
+	}
+
+	/// @brief Handle one command line
+	/// @param clientId Client that sent it
+	/// @param line Command
+	/// @return False if the client asked to close the connection
+	bool handle(int clientId, const std::string& line)
+	{
+		std::istringstream tokens(line);
+		std::string command;
+		if (!(tokens >> command)) return true;
+
+		if (command == "new") {
+			createSession(clientId, tokens);
+		}
+		else if (command == "list") {
+			for (const auto& entry : m_sessions) {
+				if (!entry.second.isAIGame && entry.second.players[1] < 0) {
+					send(clientId, "open " + std::to_string(entry.first) + " " + Variants::get(entry.second.match.getPosition().variant).name);
+				}
+			}
+			send(clientId, "end");
+		}
+		else if (command == "bye") {
+			return false;
+		}
+		else {
+			int sessionId = 0;
+			tokens >> sessionId;
+			auto found = m_sessions.find(sessionId);
+			if (found == m_sessions.end()) {
+				send(clientId, "error " + std::to_string(sessionId) + " no such game");
+				return true;
+			}
+
+			if (command == "join") joinSession(clientId, sessionId);
+			else if (command == "move") {
+				std::string move;
+				tokens >> move;
+				playMove(clientId, sessionId, move);
+			}
+			else if (command == "state") sendState(clientId, sessionId);
+			else if (command == "leave") leaveSession(clientId, sessionId);
+			else send(clientId, "error " + std::to_string(sessionId) + " unknown command " + command);
+		}
+		return true;
+	}
+
+	/// @brief Handle "new <variant> pvp" and "new <variant> ai <strategy> [difficulty]"
+	/// @param clientId Client hosting the game
+	/// @param tokens Rest of the command line
+	void createSession(int clientId, std::istringstream& tokens)
+	{
+		std::string variantName, mode, strategyName, difficulty;
+		tokens >> variantName >> mode >> strategyName >> difficulty;
+
+		const int variant = Variants::find(variantName);
+		if (variant < 0) {
+			send(clientId, "error 0 unknown variant " + variantName);
+			return;
+		}
+
+		Session session;
+		session.match = Match(variant, m_settings.maxMoves);
+		session.players[0] = clientId;
+		if (mode == "ai") {
+			int strategy = -1;
+			for (int i = 0; i < STRATEGY_COUNT; ++i) {
+				if (strategyName == STRATEGY_NAMES[i]) strategy = i;
+			}
+			if (strategy < 0) {
+				send(clientId, "error 0 unknown strategy " + strategyName);
+				return;
+			}
+			session.isAIGame = true;
+			session.strategy = static_cast<Strategy>(strategy);
+			// Difficulties map to the depths Game::executeAIMove searches at
+			session.depth = difficulty == "easy" ? 2 : 3;
+		}
+		else if (mode != "pvp") {
+			send(clientId, "error 0 unknown mode " + mode);
+			return;
+		}
+
+		const int sessionId = m_nextSessionId++;
+		m_sessions[sessionId] = session;
+		m_clients[clientId].sessions.push_back(sessionId);
+		send(clientId, "created " + std::to_string(sessionId) + " 1");
+	}
+
+	/// @brief Handle "join <id>": take the empty Player 2 seat of a PvP game
+	/// @param clientId Joining client
+	/// @param sessionId Game to join
+	void joinSession(int clientId, int sessionId)
+	{
+		Session& session = m_sessions[sessionId];
+		if (session.isAIGame || session.players[1] >= 0) {
+			send(clientId, "error " + std::to_string(sessionId) + " game is full");
+			return;
+		}
+		session.players[1] = clientId;
+		if (session.players[0] != clientId) m_clients[clientId].sessions.push_back(sessionId);
+		send(clientId, "joined " + std::to_string(sessionId) + " 2");
+		send(session.players[0], "opponent " + std::to_string(sessionId));
+	}
+
+	/// @brief Handle "leave <id>": close the game, telling the other player
+	/// @param clientId Leaving client
+	/// @param sessionId Game to leave
+	void leaveSession(int clientId, int sessionId)
+	{
+		auto found = m_sessions.find(sessionId);
+		if (found == m_sessions.end()) return;
+		Session& session = found->second;
+		if (session.players[0] != clientId && session.players[1] != clientId) {
+			send(clientId, "error " + std::to_string(sessionId) + " not your game");
+			return;
+		}
+
+		send(clientId, "left " + std::to_string(sessionId));
+		for (int player : session.players) {
+			if (player >= 0 && player != clientId) send(player, "over " + std::to_string(sessionId) + " abandoned");
+		}
+		closeSession(sessionId);
+	}
+
+	/// @brief Forget a session (a move still being searched for it is dropped on arrival)
+	/// @param sessionId Session to close
+	void closeSession(int sessionId)
+	{
+		auto found = m_sessions.find(sessionId);
+		if (found == m_sessions.end()) return;
+		for (int player : found->second.players) {
+			auto client = m_clients.find(player);
+			if (client == m_clients.end()) continue;
+			auto& sessions = client->second.sessions;
+			sessions.erase(std::remove(sessions.begin(), sessions.end(), sessionId), sessions.end());
+		}
+		m_sessions.erase(found);
+	}
+
+	/// @brief Handle "move <id> <move>" from a player
+	/// @param clientId Client sending the move
+	/// @param sessionId Game the move is for
+	/// @param text Move in MoveNotation
+	void playMove(int clientId, int sessionId, const std::string& text)
+	{
+		Session& session = m_sessions[sessionId];
+		const int side = session.match.getPosition().sideToMove();
+		if (session.players[side] != clientId || session.aiThinking) {
+			send(clientId, "error " + std::to_string(sessionId) + " not your turn");
+			return;
+		}
+
+		Move move;
+		if (!MoveNotation::parse(session.match.getPosition(), text, move) || !session.match.play(move)) {
+			send(clientId, "error " + std::to_string(sessionId) + " illegal move " + text);
+			return;
+		}
+		afterMove(sessionId, text);
+	}
+
+	/// @brief Apply a move found by a worker
+	/// @param result Move and search time
+	void applyAIMove(const AIResult& result)
+	{
+		auto found = m_sessions.find(result.sessionId);
+		if (found == m_sessions.end()) return;
+		Session& session = found->second;
+		session.aiThinking = false;
+		session.usedMicros += result.micros;
+
+		if (result.move.pieceIndex < 0) {
+			// The AI has no move, so it can never complete a line: the player wins
+			broadcast(session, "over " + std::to_string(result.sessionId) + " player1");
+			closeSession(result.sessionId);
+			return;
+		}
+
+		const std::string text = MoveNotation::format(session.match.getPosition(), result.move);
+		if (!session.match.play(result.move)) {
+			// The search and the referee disagree on the rules: a server fault, not a result of the game
+			std::cout << "Session " << result.sessionId << ": the referee rejected AI move " << text << "\n";
+			broadcast(session, "error " + std::to_string(result.sessionId) + " server rejected the AI move");
+			broadcast(session, "over " + std::to_string(result.sessionId) + " abandoned");
+			closeSession(result.sessionId);
+			return;
+		}
+		afterMove(result.sessionId, text);
+	}
+
+	/// @brief Tell the players about a move, then end the game or queue the AI's reply
+	/// @param sessionId Game the move was played in
+	/// @param text Move in MoveNotation
+	void afterMove(int sessionId, const std::string& text)
+	{
+		Session& session = m_sessions[sessionId];
+		broadcast(session, "moved " + std::to_string(sessionId) + " " + text);
+
+		if (session.match.isOver()) {
+			const Match::Result result = session.match.getResult();
+			broadcast(session, "over " + std::to_string(sessionId) + " "
+				+ (result == Match::Result::Player1Won ? "player1" : result == Match::Result::Player2Won ? "player2" : "draw"));
+			closeSession(sessionId);
+			return;
+		}
+
+		const Position& position = session.match.getPosition();
+		if (session.isAIGame && !position.player1ToMove) {
+			session.aiThinking = true;
+			AIJob job;
+			job.sessionId = sessionId;
+			job.usedMicros = session.usedMicros;
+			job.position = position;
+			job.history = session.match.getHistory();
+			job.lastMove = session.match.getLastMove(position.sideToMove());
+			job.strategy = session.strategy;
+			job.depth = session.depth;
+			m_pool.submit(std::move(job));
+		}
+	}
+
+	/// @brief Handle "state <id>"
+	/// @param clientId Asking client
+	/// @param sessionId Game to describe
+	void sendState(int clientId, int sessionId)
+	{
+		const Position& position = m_sessions[sessionId].match.getPosition();
+		const int cellCount = position.gridSize * position.gridSize;
+
+		// One character per cell: '.', Player 1's pieces in upper case, Player 2's in lower case
+		std::string cells(cellCount, '.');
+		for (int cell = 0; cell < cellCount; ++cell) {
+			if (position.isEmpty(cell)) continue;
+			const char letter = MoveNotation::pieceLetter(position.typeAt(cell));
+			cells[cell] = position.isPlayer1At(cell) ? letter : static_cast<char>(std::tolower(letter));
+		}
+		send(clientId, "state " + std::to_string(sessionId) + " " + Variants::get(position.variant).name + " "
+			+ (position.player1ToMove ? "p1 " : "p2 ") + (position.placementPhase ? "place " : "move ") + cells);
+	}
+
+	/// @brief Server options
+	ServerSettings m_settings;
+	/// @brief AI workers
+	AIWorkerPool m_pool;
+	/// @brief Listening socket
+	sf::TcpListener m_listener;
+	/// @brief Waits on the listener and every client at once
+	sf::SocketSelector m_selector;
+	/// @brief Connected clients by id
+	std::map<int, Client> m_clients;
+	/// @brief Open games by id
+	std::unordered_map<int, Session> m_sessions;
+	/// @brief Id of the next client
+	int m_nextClientId = 1;
+	/// @brief Id of the next game
+	int m_nextSessionId = 1;
+};
+
+/**
+ * @brief Entry point for the game server
+ * @param argc Number of command line arguments
+ * @param argv Options
+ * @return int Exit status (1 if the server could not start)
+ */
+int main(int argc, char* argv[])
+{
+	ServerSettings settings;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		const int value = std::atoi(argv[i + 1]);
+		if (std::strcmp(argv[i], "--port") == 0) settings.port = static_cast<unsigned short>(value);
+		else if (std::strcmp(argv[i], "--workers") == 0) settings.workers = std::max(1, value);
+		else if (std::strcmp(argv[i], "--move-time") == 0) settings.moveTime = std::max(1, value);
+		else if (std::strcmp(argv[i], "--max-moves") == 0) settings.maxMoves = std::max(0, value);
+		else std::cout << "Ignoring unknown option " << argv[i] << "\n";
+	}
+
+	GameServer server(settings);
+	return server.run() ? 0 : 1;
+}
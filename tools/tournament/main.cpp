@@ -0,0 +1,567 @@
+/**
+ * @file main.cpp
+ * @brief Headless AI vs AI tournament runner for The Fourth Protocol
+ * @author RCH and OA-O
+ * @date December 2025
+ * @version 1.0
+ *
+ * Plays many games between two AI engines (a Strategy and a search depth
+ * each) without opening a window, on every CPU core, and reports the
+ * result with an Elo estimate.
+ *
+ * Games are played in pairs from the same opening with colours swapped, so
+ * neither engine profits from a lucky opening or from moving first. The
+ * first plies of each opening are random placements (seeded, so a run can
+ * be repeated); an opening book, if given, takes over the placements after
+ * that. Pairs are queued on a work-stealing thread pool: each worker runs
+ * the pairs of its own queue and steals from the others when it runs dry.
+ *
+ * With --sprt the run stops as soon as the sequential probability ratio
+ * test accepts either Elo hypothesis, instead of playing every game.
+ *
+ * The project defines TRACK_ALLOCATIONS, so the heap allocations of every
+ * search are counted and reported per node. With --max-allocations-per-node
+ * the run exits non-zero if either engine allocates more than that, which
+ * lets a build or CI run catch allocations creeping back into the search.
+ *
+ * Usage: tournament --a <engine> --b <engine> [--games N] [--variant NAME]
+ *                   [--threads T] [--random-plies N] [--book FILE]
+ *                   [--max-moves N] [--seed S] [--sprt ELO0 ELO1]
+ *                   [--alpha A] [--beta B] [--max-allocations-per-node X]
+ *
+ * An engine is a strategy name optionally followed by a colon and a search
+ * depth or difficulty, e.g. Aggressive:3 or Defensive:easy (default depth 3).
+ */
+
+#ifdef _DEBUG
+#pragma comment(lib,"sfml-graphics-d.lib")
+#pragma comment(lib,"sfml-system-d.lib")
+#pragma comment(lib,"sfml-window-d.lib")
+#else
+#pragma comment(lib,"sfml-graphics.lib")
+#pragma comment(lib,"sfml-system.lib")
+#pragma comment(lib,"sfml-window.lib")
+#endif
+#pragma comment(lib,"opengl32.lib")
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AI.h"
+#include "AllocationTracker.h"
+#include "Match.h"
+#include "Rules.h"
+#include "Variants.h"
+
+/// @brief Printable names of the strategies, indexed by static_cast<int>(Strategy)
+static const char* const STRATEGY_NAMES[] = { "Balanced", "FavorDiagonal", "FavorCenter", "FavorEdges", "Aggressive", "Defensive" };
+/// @brief Number of strategies
+static const int STRATEGY_COUNT = 6;
+
+/// @brief One tournament participant
+struct Engine {
+	/// @brief Evaluation strategy
+	Strategy strategy;
+	/// @brief Search depth
+	int depth;
+	/// @brief Name as given on the command line
+	std::string name;
+};
+
+/// @brief Settings shared by every game
+struct TournamentSettings {
+	/// @brief Index of the variant in the Variants table
+	int variant = 0;
+	/// @brief Number of random placement plies at the start of each opening
+	int randomPlies = 4;
+	/// @brief Movement-phase moves after which a game is drawn (0 for no limit)
+	int maxMoves = 300;
+	/// @brief Opening book consulted after the random plies (empty for none)
+	std::string bookPath;
+};
+
+/// @brief Totals for one engine over the games played so far
+struct EngineTotals {
+	/// @brief Number of moves chosen by the engine
+	uint64_t moves = 0;
+	/// @brief Search nodes over all of those moves
+	uint64_t nodes = 0;
+	/// @brief Thinking time over all of those moves, in microseconds
+	uint64_t micros = 0;
+	/// @brief Heap allocations over all of those searches (zero unless TRACK_ALLOCATIONS is defined)
+	uint64_t allocations = 0;
+};
+
+/// @brief How one game ended
+struct GameResult {
+	/// @brief Result of the game (never InProgress)
+	Match::Result result;
+	/// @brief Side whose move the match rejected, scored as a loss (-1 if none)
+	int illegalSide = -1;
+};
+
+/// @brief Placement made at random at the start of an opening
+struct OpeningMove {
+	/// @brief Index of the piece to place
+	int piece;
+	/// @brief Row-major cell to place it on
+	int cell;
+};
+
+/**
+ * @brief Thread pool in which idle workers steal queued jobs from busy ones
+ *
+ * Every worker has its own queue and takes jobs from the back of it; when it
+ * is empty the worker takes from the front of another worker's queue. Jobs
+ * get the index of the worker running them, so they can use per-worker
+ * state (such as an AI instance) without locking.
+ */
+class WorkStealingPool
+{
+public:
+	/// @brief Job run by a worker
+	typedef std::function<void(int worker)> Job;
+
+	/// @brief Constructor
+	/// @param threadCount Number of workers
+	explicit WorkStealingPool(int threadCount) : m_queues(threadCount) {}
+
+	/// @brief Queue a job, spreading jobs over the workers' queues in turn
+	/// @param job Job to run
+	void submit(Job job)
+	{
+		Queue& queue = m_queues[m_nextQueue++ % m_queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(std::move(job));
+	}
+
+	/// @brief Run every queued job and return once all of them have finished
+	void run()
+	{
+		std::vector<std::thread> threads;
+		for (int worker = 0; worker < static_cast<int>(m_queues.size()); ++worker) {
+			threads.emplace_back([this, worker]() {
+				Job job;
+				while (takeJob(worker, job)) job(worker);
+			});
+		}
+		for (auto& thread : threads) thread.join();
+	}
+
+private:
+	/// @brief One worker's jobs
+	struct Queue {
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	/// @brief Take the worker's next job, stealing one if its own queue is empty
+	/// @param worker Index of the worker
+	/// @param job Receives the job
+	/// @return False if every queue is empty (jobs never queue new jobs, so the worker can stop)
+	bool takeJob(int worker, Job& job)
+	{
+		const int count = static_cast<int>(m_queues.size());
+		for (int i = 0; i < count; ++i) {
+			Queue& queue = m_queues[(worker + i) % count];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (queue.jobs.empty()) continue;
+
+			if (i == 0) {
+				job = std::move(queue.jobs.back());
+				queue.jobs.pop_back();
+			} else {
+				job = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+			}
+			return true;
+		}
+		return false;
+	}
+
+	/// @brief Job queue of each worker (a deque never moves its elements, so the mutexes stay put)
+	std::deque<Queue> m_queues;
+	/// @brief Queue the next submitted job goes to
+	size_t m_nextQueue = 0;
+};
+
+/**
+ * @brief Parses an engine given as Strategy[:depth|easy|medium|hard]
+ * @param text Engine description
+ * @param engine Receives the engine
+ * @return False if the strategy or depth is not recognised
+ */
+static bool parseEngine(const std::string& text, Engine& engine)
+{
+	const size_t colon = text.find(':');
+	const std::string strategyName = text.substr(0, colon);
+	const std::string depthName = colon == std::string::npos ? "" : text.substr(colon + 1);
+
+	auto equalsIgnoreCase = [](const std::string& a, const char* b) {
+		return a.size() == std::strlen(b) && std::equal(a.begin(), a.end(), b,
+			[](char x, char y) { return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y)); });
+	};
+
+	int strategy = -1;
+	for (int i = 0; i < STRATEGY_COUNT; ++i) {
+		if (equalsIgnoreCase(strategyName, STRATEGY_NAMES[i])) strategy = i;
+	}
+	if (strategy < 0) return false;
+
+	// Difficulties map to the depths Game::executeAIMove searches at
+	int depth = 3;
+	if (equalsIgnoreCase(depthName, "easy")) depth = 2;
+	else if (equalsIgnoreCase(depthName, "medium") || equalsIgnoreCase(depthName, "hard")) depth = 3;
+	else if (!depthName.empty()) depth = std::atoi(depthName.c_str());
+	if (depth < 1) return false;
+
+	engine = { static_cast<Strategy>(strategy), depth, text };
+	return true;
+}
+
+/**
+ * @brief Draws a random opening that does not already decide the game
+ * @param settings Tournament settings
+ * @param random Random source
+ * @return Placements for alternating sides, Player 1 first
+ */
+static std::vector<OpeningMove> randomOpening(const TournamentSettings& settings, std::mt19937& random)
+{
+	const Variant& rules = Variants::get(settings.variant);
+	const int plies = std::min(settings.randomPlies, 2 * rules.pieceCount);
+
+	for (;;) {
+		Position position = Position::start(settings.variant);
+		std::vector<OpeningMove> opening;
+		bool won = false;
+
+		for (int ply = 0; ply < plies && !won; ++ply) {
+			const int side = position.sideToMove();
+
+			// Same placement freedom as the search: anywhere on small boards, near the pieces on large ones
+			std::vector<int> cells;
+			const BoardMask near = position.emptyCellsNear(rules.placementRadius);
+			for (int cell = 0; cell < rules.gridSize * rules.gridSize; ++cell) {
+				if (position.isEmpty(cell) && (rules.placementRadius == 0 || near.test(cell))) cells.push_back(cell);
+			}
+			std::vector<int> pieces;
+			for (int i = 0; i < position.pieceCount[side]; ++i) {
+				if (position.pieceCells[side][i] == Position::NONE) pieces.push_back(i);
+			}
+
+			OpeningMove move = { pieces[random() % pieces.size()], cells[random() % cells.size()] };
+			won = Rules::placePiece(position, side, move.piece, move.cell) == Rules::Outcome::Won;
+			position.player1ToMove = !position.player1ToMove;
+			opening.push_back(move);
+		}
+		if (!won) return opening;
+	}
+}
+
+/**
+ * @brief Plays one game to the end
+ * @param ais AI of each side, [Player 1, Player 2]
+ * @param engines Engine of each side, [Player 1, Player 2]
+ * @param settings Tournament settings
+ * @param opening Random placements to start from
+ * @param totals Receives each side's move count, nodes, time and allocations
+ * @return Result of the game, and the side that made an illegal move if any
+ */
+static GameResult playGame(AI* const ais[2], const Engine* const engines[2], const TournamentSettings& settings,
+	const std::vector<OpeningMove>& opening, EngineTotals totals[2])
+{
+	Match match(settings.variant, settings.maxMoves);
+	const int gridSize = match.getPosition().gridSize;
+	for (const auto& move : opening) {
+		match.play(Move(move.piece, -1, -1, move.cell / gridSize, move.cell % gridSize));
+	}
+
+	while (!match.isOver()) {
+		const Position& position = match.getPosition();
+		const int side = position.sideToMove();
+		AI& ai = *ais[side];
+		auto start = std::chrono::steady_clock::now();
+		Move move = ai.findBestMove(position, engines[side]->depth, false, match.getLastMove(side), engines[side]->strategy, match.getHistory());
+		auto elapsed = std::chrono::steady_clock::now() - start;
+
+		totals[side].moves++;
+		totals[side].nodes += ai.getNodesSearched();
+		totals[side].micros += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+		totals[side].allocations += ai.getSearchStats().allocations;
+
+		// A side that cannot move loses, since it can never complete a line
+		if (move.pieceIndex < 0) return { side == 0 ? Match::Result::Player2Won : Match::Result::Player1Won };
+		// Scored the same way; the caller reports it, since workers must not write to the console
+		if (!match.play(move)) return { side == 0 ? Match::Result::Player2Won : Match::Result::Player1Won, side };
+	}
+	return { match.getResult() };
+}
+
+/**
+ * @brief Converts an expected score to an Elo difference
+ * @param score Expected score in (0, 1)
+ * @return Elo difference
+ */
+static double scoreToElo(double score)
+{
+	score = std::min(std::max(score, 1e-6), 1.0 - 1e-6);
+	return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+/**
+ * @brief Converts an Elo difference to an expected score
+ * @param elo Elo difference
+ * @return Expected score
+ */
+static double eloToScore(double elo)
+{
+	return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+/// @brief Running result of engine A against engine B
+struct Standings {
+	/// @brief Games won by A
+	int wins = 0;
+	/// @brief Games drawn
+	int draws = 0;
+	/// @brief Games lost by A
+	int losses = 0;
+
+	/// @brief Get the number of games played
+	/// @return Wins, draws and losses
+	int games() const { return wins + draws + losses; }
+
+	/// @brief Get A's mean score per game
+	/// @return Score in [0, 1], counting a draw as half a win
+	double score() const { return (wins + 0.5 * draws) / games(); }
+
+	/// @brief Get the variance of A's score in a single game
+	/// @return Variance of the per-game score
+	double variance() const
+	{
+		const double mean = score();
+		return (wins * (1.0 - mean) * (1.0 - mean) + draws * (0.5 - mean) * (0.5 - mean) + losses * mean * mean) / games();
+	}
+
+	/**
+	 * @brief Gets the log-likelihood ratio of Elo1 over Elo0 (normal approximation of the GSPRT)
+	 * @param elo0 Elo difference of the null hypothesis
+	 * @param elo1 Elo difference of the alternative hypothesis
+	 * @return Log-likelihood ratio (0 until the games show any variance)
+	 */
+	double logLikelihoodRatio(double elo0, double elo1) const
+	{
+		const double var = variance();
+		if (games() == 0 || var <= 0.0) return 0.0;
+		const double s0 = eloToScore(elo0);
+		const double s1 = eloToScore(elo1);
+		return games() * (s1 - s0) * (2.0 * score() - s0 - s1) / (2.0 * var);
+	}
+};
+
+/**
+ * @brief Prints the standings with a 95% confidence interval on the Elo difference
+ * @param engines Engine A and engine B
+ * @param standings Results from A's point of view
+ */
+static void printStandings(const Engine engines[2], const Standings& standings)
+{
+	const double score = standings.score();
+	const double margin = 1.96 * std::sqrt(standings.variance() / standings.games());
+	const double elo = scoreToElo(score);
+	const double errorBar = (scoreToElo(score + margin) - scoreToElo(score - margin)) / 2.0;
+
+	std::cout << engines[0].name << " vs " << engines[1].name << ": "
+		<< standings.wins << " W / " << standings.draws << " D / " << standings.losses << " L ("
+		<< standings.games() << " games, score " << std::fixed << std::setprecision(3) << score
+		<< ", Elo " << std::setprecision(1) << elo << " +/- " << errorBar << ")\n";
+}
+
+/**
+ * @brief Entry point for the tournament runner
+ * @param argc Number of command line arguments
+ * @param argv Options
+ * @return int Exit status (0 on success, 1 on any error)
+ */
+int main(int argc, char* argv[])
+{
+	Engine engines[2];
+	bool hasEngine[2] = { false, false };
+	TournamentSettings settings;
+	int games = 1000;
+	int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+	unsigned seed = 1;
+	bool useSprt = false;
+	double elo0 = 0.0, elo1 = 10.0, alpha = 0.05, beta = 0.05;
+	double maxAllocationsPerNode = -1.0;
+
+	for (int i = 1; i + 1 < argc; i += 2) {
+		const char* value = argv[i + 1];
+		if (std::strcmp(argv[i], "--a") == 0) hasEngine[0] = parseEngine(value, engines[0]);
+		else if (std::strcmp(argv[i], "--b") == 0) hasEngine[1] = parseEngine(value, engines[1]);
+		else if (std::strcmp(argv[i], "--games") == 0) games = std::atoi(value);
+		else if (std::strcmp(argv[i], "--threads") == 0) threadCount = std::atoi(value);
+		else if (std::strcmp(argv[i], "--random-plies") == 0) settings.randomPlies = std::atoi(value);
+		else if (std::strcmp(argv[i], "--book") == 0) settings.bookPath = value;
+		else if (std::strcmp(argv[i], "--max-moves") == 0) settings.maxMoves = std::atoi(value);
+		else if (std::strcmp(argv[i], "--seed") == 0) seed = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+		else if (std::strcmp(argv[i], "--alpha") == 0) alpha = std::atof(value);
+		else if (std::strcmp(argv[i], "--beta") == 0) beta = std::atof(value);
+		else if (std::strcmp(argv[i], "--max-allocations-per-node") == 0) maxAllocationsPerNode = std::atof(value);
+		else if (std::strcmp(argv[i], "--variant") == 0) {
+			settings.variant = Variants::find(value);
+			if (settings.variant < 0) {
+				std::cout << "Unknown variant " << value << "\n";
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--sprt") == 0 && i + 2 < argc) {
+			useSprt = true;
+			elo0 = std::atof(value);
+			elo1 = std::atof(argv[i + 2]);
+			++i;
+		}
+		else std::cout << "Ignoring unknown option " << argv[i] << "\n";
+	}
+	if (!hasEngine[0] || !hasEngine[1]) {
+		std::cout << "Usage: tournament --a <engine> --b <engine> [--games N] [--variant NAME] [--threads T]\n"
+			"                  [--random-plies N] [--book FILE] [--max-moves N] [--seed S]\n"
+			"                  [--sprt ELO0 ELO1] [--alpha A] [--beta B] [--max-allocations-per-node X]\n"
+			"An engine is Strategy[:depth|easy|medium|hard], with Strategy one of";
+		for (auto name : STRATEGY_NAMES) std::cout << " " << name;
+		std::cout << "\n";
+		return 1;
+	}
+	if (maxAllocationsPerNode >= 0.0 && !AllocationTracker::ENABLED) {
+		std::cout << "--max-allocations-per-node needs a build with TRACK_ALLOCATIONS defined\n";
+		return 1;
+	}
+	if (threadCount < 1) threadCount = 1;
+	const int pairCount = std::max(1, (games + 1) / 2);
+
+	std::cout << "Playing " << 2 * pairCount << " games of " << Variants::get(settings.variant).name
+		<< " on " << threadCount << " threads";
+	if (useSprt) std::cout << ", SPRT Elo0 " << elo0 << " Elo1 " << elo1 << " alpha " << alpha << " beta " << beta;
+	std::cout << "\n";
+
+	// One pair of AIs per worker, so the search tables are never shared between threads
+	std::vector<std::unique_ptr<AI>> workerAIs;
+	for (int i = 0; i < 2 * threadCount; ++i) {
+		workerAIs.emplace_back(new AI());
+		if (!settings.bookPath.empty() && !workerAIs.back()->openOpeningBook(settings.bookPath) && i == 0) {
+			std::cout << "Could not open opening book " << settings.bookPath << ", searching every placement\n";
+		}
+	}
+
+	// Openings are drawn up front from the seed, so a run does not depend on the thread count
+	std::mt19937 random(seed);
+	std::vector<std::vector<OpeningMove>> openings;
+	for (int i = 0; i < pairCount; ++i) openings.push_back(randomOpening(settings, random));
+
+	Standings standings;
+	EngineTotals totals[2];
+	std::mutex resultMutex;
+	std::atomic<bool> stopped{ false };
+	const double lowerBound = std::log(beta / (1.0 - alpha));
+	const double upperBound = std::log((1.0 - beta) / alpha);
+	int sprtDecision = 0;
+
+	WorkStealingPool pool(threadCount);
+	for (int pair = 0; pair < pairCount; ++pair) {
+		pool.submit([&, pair](int worker) {
+			if (stopped) return;
+
+			// Engine A plays Player 1 in the first game and Player 2 in the second
+			Standings pairStandings;
+			EngineTotals pairTotals[2];
+			std::vector<const Engine*> illegalMoves;
+			for (int aSide = 0; aSide < 2; ++aSide) {
+				AI* const ais[2] = { workerAIs[2 * worker].get(), workerAIs[2 * worker + 1].get() };
+				const Engine* const sides[2] = { &engines[aSide], &engines[1 - aSide] };
+				EngineTotals sideTotals[2];
+				const GameResult game = playGame(ais, sides, settings, openings[pair], sideTotals);
+				const Match::Result result = game.result;
+				if (game.illegalSide >= 0) illegalMoves.push_back(sides[game.illegalSide]);
+
+				if (result == Match::Result::Draw) pairStandings.draws++;
+				else if ((result == Match::Result::Player1Won) == (aSide == 0)) pairStandings.wins++;
+				else pairStandings.losses++;
+
+				for (int side = 0; side < 2; ++side) {
+					EngineTotals& engineTotals = pairTotals[side == aSide ? 0 : 1];
+					engineTotals.moves += sideTotals[side].moves;
+					engineTotals.nodes += sideTotals[side].nodes;
+					engineTotals.micros += sideTotals[side].micros;
+					engineTotals.allocations += sideTotals[side].allocations;
+				}
+			}
+
+			std::lock_guard<std::mutex> lock(resultMutex);
+			if (stopped) return;
+			for (const Engine* engine : illegalMoves) {
+				std::cout << "\nIllegal move by " << engine->name << ", game scored as a loss\n";
+			}
+			standings.wins += pairStandings.wins;
+			standings.draws += pairStandings.draws;
+			standings.losses += pairStandings.losses;
+			for (int i = 0; i < 2; ++i) {
+				totals[i].moves += pairTotals[i].moves;
+				totals[i].nodes += pairTotals[i].nodes;
+				totals[i].micros += pairTotals[i].micros;
+				totals[i].allocations += pairTotals[i].allocations;
+			}
+
+			if (useSprt) {
+				const double llr = standings.logLikelihoodRatio(elo0, elo1);
+				if (llr <= lowerBound || llr >= upperBound) {
+					sprtDecision = llr >= upperBound ? 1 : -1;
+					stopped = true;
+				}
+			}
+			if (standings.games() % 100 == 0 || stopped) {
+				std::cout << "\r" << standings.games() << " / " << 2 * pairCount << " games: "
+					<< standings.wins << " W / " << standings.draws << " D / " << standings.losses << " L" << std::flush;
+			}
+		});
+	}
+	pool.run();
+	std::cout << "\n";
+
+	printStandings(engines, standings);
+	bool tooManyAllocations = false;
+	for (int i = 0; i < 2; ++i) {
+		const double moves = static_cast<double>(std::max<uint64_t>(totals[i].moves, 1));
+		std::cout << "  " << engines[i].name << ": " << std::setprecision(0) << totals[i].nodes / moves
+			<< " nodes/move, " << std::setprecision(2) << totals[i].micros / moves / 1000.0 << " ms/move";
+		if (AllocationTracker::ENABLED) {
+			const double allocationsPerNode = totals[i].nodes > 0 ? static_cast<double>(totals[i].allocations) / totals[i].nodes : 0.0;
+			std::cout << ", " << std::setprecision(3) << allocationsPerNode << " allocations/node";
+			if (maxAllocationsPerNode >= 0.0 && allocationsPerNode > maxAllocationsPerNode) tooManyAllocations = true;
+		}
+		std::cout << "\n";
+	}
+	if (useSprt) {
+		const double llr = standings.logLikelihoodRatio(elo0, elo1);
+		std::cout << "SPRT: LLR " << std::setprecision(2) << llr << " [" << lowerBound << ", " << upperBound << "] - "
+			<< (sprtDecision > 0 ? "H1 accepted" : sprtDecision < 0 ? "H0 accepted" : "inconclusive") << "\n";
+	}
+	if (tooManyAllocations) {
+		std::cout << "Error: more than " << std::setprecision(3) << maxAllocationsPerNode << " allocations per node\n";
+		return 1;
+	}
+	return 0;
+}